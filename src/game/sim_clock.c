@@ -0,0 +1,14 @@
+#include "sim_clock.h"
+
+void SimClock_Reset(SimClock* c) {
+    c->accumulator = 0.0;
+    c->ticks = 0;
+}
+
+void SimClock_Tick(SimClock* c) {
+    c->ticks++;
+}
+
+float SimClock_Seconds(const SimClock* c) {
+    return (float)((double)c->ticks / SIM_TICK_HZ);
+}
@@ -0,0 +1,24 @@
+// Relógio de simulação em passo fixo: a física avança em ticks inteiros,
+// independente do FPS de desenho. As constantes de movimento (MOVE_SPEED,
+// gravidade, pulo, ventiladores, caixas, barras) são por tick. Aqui só a contagem
+// (vale também sem janela); o avanço pelo tempo real e as teclas ficam em sim_input.h.
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <stdbool.h>
+
+#define SIM_TICK_HZ              60                       // taxa para a qual as constantes foram ajustadas
+#define SIM_TICK_DT              (1.0f / SIM_TICK_HZ)
+
+typedef struct SimClock {
+    double accumulator;   // segundos ainda não simulados
+    long long ticks;      // ticks simulados desde o início da fase
+} SimClock;
+
+void SimClock_Reset(SimClock* c);
+// Conta um tick simulado (chamar uma vez por passo)
+void SimClock_Tick(SimClock* c);
+// Tempo da fase em segundos, derivado só da contagem de ticks
+float SimClock_Seconds(const SimClock* c);
+
+#endif
@@ -0,0 +1,50 @@
+// Número da física, escolhido na compilação. Padrão: float (o jogo de sempre).
+// Com -DSIM_FIXED_POINT a física passa a contar em ponto fixo 24.8 (inteiro de
+// 32 bits, 1/256 px): gravidade, pulo, andar, caixas, barras e ventiladores
+// somam e multiplicam inteiros, e todo valor guardado de volta nos Rectangle/
+// Vector2 da raylib cai exatamente na grade de 1/256 px. Com isso as somas,
+// subtrações e metades da resolução de colisão também ficam exatas em float e o
+// estado depois de cada tick é o mesmo bit a bit em qualquer compilador/flag.
+// 24.8 e não 16.16: um float só guarda 24 bits de mantissa, e os mapas passam
+// de 256 px; com 8 bits de fração qualquer posição até 65536 px volta exata.
+#ifndef SIM_FIXED_H
+#define SIM_FIXED_H
+
+#include <stdint.h>
+#include <math.h>
+#include "sim_types.h"
+
+#ifdef SIM_FIXED_POINT
+
+typedef int32_t SimNum;
+#define SIM_FRAC_BITS 8
+#define SIM_ONE       (1 << SIM_FRAC_BITS)
+
+// Literal da física (constante de compilação, arredondada para a grade)
+#define SIM_NUM(lit)  ((SimNum)((lit) * SIM_ONE + ((lit) >= 0 ? 0.5 : -0.5)))
+
+static inline SimNum SimNum_FromFloat(float f) { return (SimNum)lrintf(f * (float)SIM_ONE); }
+static inline float SimNum_ToFloat(SimNum v) { return (float)v / (float)SIM_ONE; }
+static inline SimNum SimNum_Mul(SimNum a, SimNum b) { return (SimNum)(((int64_t)a * b) / SIM_ONE); }
+
+#else
+
+typedef float SimNum;
+#define SIM_NUM(lit)  ((float)(lit))
+
+static inline SimNum SimNum_FromFloat(float f) { return f; }
+static inline float SimNum_ToFloat(SimNum v) { return v; }
+static inline SimNum SimNum_Mul(SimNum a, SimNum b) { return a * b; }
+
+#endif
+
+static inline SimNum SimNum_Abs(SimNum v) { return v < 0 ? -v : v; }
+
+// Leva um valor de estado para a grade do modo fixo (no modo float não muda nada)
+static inline float SimQuantize(float f) { return SimNum_ToFloat(SimNum_FromFloat(f)); }
+
+static inline Rectangle SimQuantizeRect(Rectangle r) {
+    return (Rectangle){ SimQuantize(r.x), SimQuantize(r.y), SimQuantize(r.width), SimQuantize(r.height) };
+}
+
+#endif
@@ -0,0 +1,48 @@
+#include "sim_input.h"
+#include "raylib.h"
+
+static int gKeys[SIM_MAX_INPUT_KEYS];
+static bool gLatched[SIM_MAX_INPUT_KEYS];
+static int gKeyCount = 0;
+
+static int FindKey(int key) {
+    for (int i = 0; i < gKeyCount; ++i) if (gKeys[i] == key) return i;
+    if (gKeyCount >= SIM_MAX_INPUT_KEYS) return -1;
+    gKeys[gKeyCount] = key;
+    gLatched[gKeyCount] = IsKeyPressed(key);
+    return gKeyCount++;
+}
+
+static void PollKeys(void) {
+    for (int i = 0; i < gKeyCount; ++i) {
+        if (IsKeyPressed(gKeys[i])) gLatched[i] = true;
+    }
+}
+
+void SimClock_Start(SimClock* c) {
+    SimClock_Reset(c);
+    for (int i = 0; i < gKeyCount; ++i) gLatched[i] = false;
+}
+
+int SimClock_Advance(SimClock* c, float frameDt) {
+    PollKeys();
+    if (frameDt > 0.0f) c->accumulator += frameDt;
+    // Folga de 2% de tick: com vsync em 60 Hz o dt oscila em volta de 1/60 e,
+    // sem ela, os frames alternariam entre 0 e 2 ticks
+    int n = (int)(c->accumulator * SIM_TICK_HZ + 0.02);
+    if (n > SIM_MAX_TICKS_PER_FRAME) {
+        n = SIM_MAX_TICKS_PER_FRAME;
+        c->accumulator = 0.0;
+    } else {
+        c->accumulator -= (double)n / SIM_TICK_HZ;
+    }
+    return n;
+}
+
+bool SimInput_Pressed(int key) {
+    int i = FindKey(key);
+    if (i < 0) return IsKeyPressed(key);
+    bool v = gLatched[i];
+    gLatched[i] = false;
+    return v;
+}
@@ -0,0 +1,22 @@
+// Lado de tempo real do relógio de simulação (só no jogo com janela): converte o
+// tempo de cada frame em ticks e trava os toques de tecla até um tick consumir.
+#ifndef SIM_INPUT_H
+#define SIM_INPUT_H
+
+#include <stdbool.h>
+#include "sim_clock.h"
+
+#define SIM_MAX_TICKS_PER_FRAME  8                        // frame muito lento: descarta o resto em vez de travar
+#define SIM_MAX_INPUT_KEYS       16
+
+// SimClock_Reset e descarta toques travados de antes (início de cada fase)
+void SimClock_Start(SimClock* c);
+// Soma o tempo do frame e devolve quantos ticks simular agora (0..SIM_MAX_TICKS_PER_FRAME).
+// Também registra as teclas apertadas neste frame para SimInput_Pressed.
+int SimClock_Advance(SimClock* c, float frameDt);
+
+// "Apertou" com trava: um toque fica guardado até o próximo tick que o consumir,
+// então não se perde em frames sem tick nem vale duas vezes em frames com vários.
+bool SimInput_Pressed(int key);
+
+#endif
@@ -0,0 +1,25 @@
+// Testes de retângulo do núcleo de simulação, sem chamar a raylib: o binário sem
+// janela (tools/sim_headless.c) usa só os tipos dela, não a biblioteca. Mesma regra
+// de CheckCollisionRecs/GetCollisionRec: encostar na borda não é sobreposição.
+#ifndef SIM_RECT_H
+#define SIM_RECT_H
+
+#include <stdbool.h>
+#include "sim_types.h"
+
+static inline bool SimRectsOverlap(Rectangle a, Rectangle b) {
+    return a.x < b.x + b.width && a.x + a.width > b.x &&
+           a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+// Parte comum de a e b (tamanho 0 se não se sobrepõem)
+static inline Rectangle SimRectIntersection(Rectangle a, Rectangle b) {
+    if (!SimRectsOverlap(a, b)) return (Rectangle){0};
+    float x0 = a.x > b.x ? a.x : b.x;
+    float y0 = a.y > b.y ? a.y : b.y;
+    float x1 = (a.x + a.width) < (b.x + b.width) ? (a.x + a.width) : (b.x + b.width);
+    float y1 = (a.y + a.height) < (b.y + b.height) ? (a.y + a.height) : (b.y + b.height);
+    return (Rectangle){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Tipos simples da raylib usados pelo núcleo de simulação (corpos, mapas, lagos).
+// No jogo vêm do próprio raylib.h; com -DSIM_HEADLESS (make headless) o núcleo
+// compila sem a raylib instalada e usa as cópias abaixo, com o mesmo layout da
+// raylib 5. Só tipos: o núcleo não chama nenhuma função da biblioteca.
+#ifndef SIM_TYPES_H
+#define SIM_TYPES_H
+
+#if !defined(SIM_HEADLESS) || defined(RAYLIB_H)
+#include "raylib.h"
+#else
+#include <stdbool.h>
+
+typedef struct Vector2 {
+    float x;
+    float y;
+} Vector2;
+
+typedef struct Rectangle {
+    float x;
+    float y;
+    float width;
+    float height;
+} Rectangle;
+
+typedef struct Color {
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+} Color;
+
+// Só para o layout de Player (sprites); sem janela fica sempre zerada
+typedef struct Texture {
+    unsigned int id;
+    int width;
+    int height;
+    int mipmaps;
+    int format;
+} Texture;
+typedef Texture Texture2D;
+#endif
+
+#endif
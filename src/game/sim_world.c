@@ -0,0 +1,313 @@
+#include "sim_world.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char* group;
+    LakeType type;
+    LakePart part;
+} SimLakeGroup;
+
+static const SimLakeGroup kDoorsMapLakes[] = {
+    { "aguameio",      LAKE_WATER,  PART_MIDDLE },
+    { "aguaesquerda",  LAKE_WATER,  PART_LEFT   },
+    { "aguadireita",   LAKE_WATER,  PART_RIGHT  },
+    { "fogomeio",      LAKE_FIRE,   PART_MIDDLE },
+    { "fogoesquerda",  LAKE_FIRE,   PART_LEFT   },
+    { "fogodireita",   LAKE_FIRE,   PART_RIGHT  },
+    { "terrameio",     LAKE_EARTH,  PART_MIDDLE },
+    { "terraesquerda", LAKE_EARTH,  PART_LEFT   },
+    { "terradireita",  LAKE_EARTH,  PART_RIGHT  },
+    { "veneno",        LAKE_POISON, PART_MIDDLE },
+};
+
+static const SimLakeGroup kCoopMapLakes[] = {
+    { "Lago_Agua_Esquerdo",   LAKE_WATER,  PART_LEFT   },
+    { "Lago_Agua_Meio",       LAKE_WATER,  PART_MIDDLE },
+    { "Lago_Agua_Direito",    LAKE_WATER,  PART_RIGHT  },
+    { "Lago_Fogo_Esquerdo",   LAKE_FIRE,   PART_LEFT   },
+    { "Lago_Fogo_Meio",       LAKE_FIRE,   PART_MIDDLE },
+    { "Lago_Fogo_Direito",    LAKE_FIRE,   PART_RIGHT  },
+    { "Lago_Marrom_Esquerdo", LAKE_EARTH,  PART_LEFT   },
+    { "Lago_Marrom_Meio",     LAKE_EARTH,  PART_MIDDLE },
+    { "Lago_Marrom_Direito",  LAKE_EARTH,  PART_RIGHT  },
+    { "Lago_Verde_Esquerda",  LAKE_POISON, PART_LEFT   },
+    { "Lago_Verde_Meio",      LAKE_POISON, PART_MIDDLE },
+    { "Lago_Verde_Direita",   LAKE_POISON, PART_RIGHT  },
+};
+
+// Barra e elevadores do mapa cooperativo (inclui as grafias erradas do TMX)
+typedef struct {
+    const char* group;
+    const char* areaGroup;
+    float speed;
+    const char* signalTokens;
+} SimPlatformDef;
+
+static const SimPlatformDef kCoopMapPlatforms[] = {
+    { "Barra1",             "AreaMovimentoBarra1", 2.0f, "barra1" },
+    { "Elevaodor1_Colisao", "Elavador1_area",      1.6f, "elevador1|elevaodor1|elavador1" },
+    { "Elevaodor2_Colisao", "Elavador2_area",      1.8f, "elevador2|elevaodor2|elavador2" },
+};
+
+// Caixas com gravidade; dois jogadores empurrando já movem
+static const BoxParams kCoopBoxParams = { 2, 1.1f, 0.88f, 9.0f, 0.45f, 10.0f };
+
+static const LakeType kPlayerElement[SIM_PLAYERS] = { LAKE_EARTH, LAKE_FIRE, LAKE_WATER };
+
+static void LoadLakes(SimWorld* w, const char* tmxPath, const SimLakeGroup* groups, int groupCount) {
+    for (int i = 0; i < groupCount; ++i) {
+        AddLakeSegments(tmxPath, groups[i].group, groups[i].type, groups[i].part,
+                        w->lakeSegs, &w->lakeSegCount, SIM_MAX_LAKE_SEGS);
+    }
+}
+
+bool SimWorld_LoadDoorsMap(SimWorld* w, const char* tmxPath, int mapW, int mapH) {
+    memset(w, 0, sizeof(*w));
+    w->mapW = mapW;
+    w->mapH = mapH;
+    w->groundDepth = 200.0f;
+
+    AddCollisionGroup(tmxPath, "colisao", w->colisoes, &w->totalColisoes, SIM_MAX_COLISOES);
+    if (!CollisionGrid_Build(&w->grid, w->colisoes, w->totalColisoes, COLLISION_GRID_CELL)) return false;
+
+    LoadLakes(w, tmxPath, kDoorsMapLakes, (int)(sizeof(kDoorsMapLakes) / sizeof(kDoorsMapLakes[0])));
+    if (!LakeIndex_Build(&w->lakeIndex, w->lakeSegs, w->lakeSegCount)) { SimWorld_Free(w); return false; }
+
+    static const char* const spawnGroups[SIM_PLAYERS] = { "spawnTerra", "spawnFogo", "spawnAgua" };
+    static const char* const doorGroups[SIM_PLAYERS]  = { "portaTerra", "portaFogo", "portaAgua" };
+    static const Vector2 spawnDefault[SIM_PLAYERS]    = { {400, 700}, {350, 700}, {300, 700} };
+    static const float doorRightOffset[SIM_PLAYERS]   = { 210.0f, 150.0f, 90.0f };
+    Rectangle buf[4];
+    for (int p = 0; p < SIM_PLAYERS; ++p) {
+        w->spawn[p] = spawnDefault[p];
+        if (ParseRectsFromGroup(tmxPath, spawnGroups[p], buf, 4) > 0) w->spawn[p] = (Vector2){ buf[0].x, buf[0].y };
+        if (ParseRectsFromGroup(tmxPath, doorGroups[p], &w->door[p], 1) == 0)
+            w->door[p] = (Rectangle){ mapW - doorRightOffset[p], mapH - 180.0f, 30.0f, 120.0f };
+    }
+
+    TriggerWorld_Init(&w->triggers);
+    for (int p = 0; p < SIM_PLAYERS; ++p) {
+        TriggerWorld_Add(&w->triggers, w->door[p], 1u << p, TriggerLatchOnEnter, &w->reached[p]);
+        PlayerInitBody(&w->players[p], (Rectangle){ w->spawn[p].x, w->spawn[p].y, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT });
+    }
+    SimClock_Reset(&w->clock);
+    return true;
+}
+
+// Área em volta da porta que já conta como "na porta" (porta vazia continua vazia)
+static Rectangle DoorReach(Rectangle door) {
+    if (door.width <= 0 || door.height <= 0) return (Rectangle){0};
+    return (Rectangle){ door.x - 12.0f, door.y - 6.0f, door.width + 24.0f, door.height + 12.0f };
+}
+
+static void LoadButtons(SimWorld* w, const char* tmxPath) {
+    char groupNames[SIM_MAX_BUTTONS][PHASE_BUTTON_NAME_LEN] = {{0}};
+    int groupCount = PhaseCollectButtonGroupNames(tmxPath, groupNames, SIM_MAX_BUTTONS);
+    Rectangle buf[8];
+    for (int g = 0; g < groupCount && w->buttonCount < SIM_MAX_BUTTONS; ++g) {
+        int n = ParseRectsFromGroup(tmxPath, groupNames[g], buf, (int)(sizeof(buf) / sizeof(buf[0])));
+        for (int r = 0; r < n && w->buttonCount < SIM_MAX_BUTTONS; ++r) {
+            SimButton* b = &w->buttons[w->buttonCount++];
+            b->rect = buf[r];
+            PhaseToLowerCopy(groupNames[g], b->nameLower, sizeof(b->nameLower));
+        }
+    }
+}
+
+bool SimWorld_LoadCoopMap(SimWorld* w, const char* tmxPath, int mapW, int mapH) {
+    memset(w, 0, sizeof(*w));
+    w->mapW = mapW;
+    w->mapH = mapH;
+    w->groundDepth = 100.0f;
+    w->doorsByPresence = true;
+
+    Rectangle* rects = (Rectangle*)malloc(sizeof(Rectangle) * SIM_MAX_COLISOES);
+    if (!rects) return false;
+    int n = ParseRectsFromGroup(tmxPath, "Colisao", rects, SIM_MAX_COLISOES);
+    for (int i = 0; i < n; ++i) w->colisoes[w->totalColisoes++].rect = rects[i];
+    free(rects);
+
+    LoadLakes(w, tmxPath, kCoopMapLakes, (int)(sizeof(kCoopMapLakes) / sizeof(kCoopMapLakes[0])));
+    if (!LakeIndex_Build(&w->lakeIndex, w->lakeSegs, w->lakeSegCount)) { SimWorld_Free(w); return false; }
+
+    // Barra e elevadores entram no fim do vetor de colisões como corpos cinemáticos.
+    // A ordem de platforms[] é a de kCoopMapPlatforms; a que faltar no mapa fica vazia.
+    int platformCol[SIM_MAX_PLATFORMS];
+    w->platformCount = (int)(sizeof(kCoopMapPlatforms) / sizeof(kCoopMapPlatforms[0]));
+    for (int i = 0; i < w->platformCount; ++i) {
+        const SimPlatformDef* def = &kCoopMapPlatforms[i];
+        Rectangle rect, area;
+        platformCol[i] = -1;
+        if (ParseRectsFromGroup(tmxPath, def->group, &rect, 1) == 0 || w->totalColisoes >= SIM_MAX_COLISOES) continue;
+        if (ParseRectsFromGroup(tmxPath, def->areaGroup, &area, 1) == 0) area = rect;
+        PhasePlatformInit(&w->platforms[i].plat, rect, area, def->speed);
+        platformCol[i] = w->totalColisoes;
+        w->colisoes[w->totalColisoes++].rect = w->platforms[i].plat.rect;
+    }
+    if (!CollisionGrid_Build(&w->grid, w->colisoes, w->totalColisoes, COLLISION_GRID_CELL)) { SimWorld_Free(w); return false; }
+    KinematicWorld_Init(&w->kinematics, &w->grid);
+    for (int i = 0; i < w->platformCount; ++i) w->platforms[i].body = KinematicWorld_Add(&w->kinematics, platformCol[i]);
+
+    Rectangle boxRects[SIM_MAX_BOXES];
+    w->boxCount = ParseRectsFromGroup(tmxPath, "Caixa", boxRects, SIM_MAX_BOXES);
+    for (int i = 0; i < w->boxCount; ++i) BoxInit(&w->boxes[i], boxRects[i]);
+    w->boxParams = kCoopBoxParams;
+
+    // A corrente do ventilador empurra para baixo, sempre ligada (jogadores e caixas)
+    Rectangle fanArea = {0};
+    if (ParseRectsFromGroup(tmxPath, "Area_Ventilador1", &fanArea, 1) == 0)
+        ParseRectsFromGroup(tmxPath, "Ventilador1", &fanArea, 1);
+    ForceFieldWorld_Init(&w->forceFields);
+    ForceFieldWorld_Add(&w->forceFields, fanArea, (Vector2){ 0.0f, 1.0f }, 0.35f, 10.0f, FORCE_FALLOFF_NONE, -1);
+
+    static const char* const doorGroups[SIM_PLAYERS] = { "Porta_Terra", "Porta_Fogo", "Porta_Agua" };
+    static const float doorRightOffset[SIM_PLAYERS]  = { 210.0f, 150.0f, 90.0f };
+    static const Vector2 spawn[SIM_PLAYERS]          = { {300, 700}, {400, 700}, {500, 700} };
+    TriggerWorld_Init(&w->triggers);
+    for (int p = 0; p < SIM_PLAYERS; ++p) {
+        if (ParseRectsFromGroup(tmxPath, doorGroups[p], &w->door[p], 1) == 0)
+            w->door[p] = (Rectangle){ mapW - doorRightOffset[p], mapH - 180.0f, 40.0f, 120.0f };
+        // Na porta da água qualquer um conta: os três juntos lá também concluem
+        uint32_t mask = (p == PHASE_WATER) ? TRIGGER_ALL_BODIES : 1u << p;
+        w->doorTrigger[p] = TriggerWorld_Add(&w->triggers, DoorReach(w->door[p]), mask, NULL, NULL);
+        w->spawn[p] = spawn[p];
+        PlayerInitBody(&w->players[p], (Rectangle){ spawn[p].x, spawn[p].y, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT });
+    }
+
+    LoadButtons(w, tmxPath);
+    const char* buttonNames[SIM_MAX_BUTTONS];
+    for (int i = 0; i < w->buttonCount; ++i) {
+        w->buttons[i].trigger = TriggerWorld_Add(&w->triggers, w->buttons[i].rect, TRIGGER_ALL_BODIES, NULL, NULL);
+        buttonNames[i] = w->buttons[i].nameLower;
+    }
+    SignalGraph_Init(&w->signals, w->buttonCount);
+    for (int i = 0; i < w->platformCount; ++i) {
+        w->platforms[i].signal = SignalGraph_AddNamedOutput(&w->signals, SIGNAL_OR, kCoopMapPlatforms[i].signalTokens,
+                                                            buttonNames, w->buttonCount);
+    }
+    SimClock_Reset(&w->clock);
+    return true;
+}
+
+void SimWorld_Free(SimWorld* w) {
+    CollisionGrid_Free(&w->grid);
+    LakeIndex_Free(&w->lakeIndex);
+    TriggerWorld_Free(&w->triggers);
+    ForceFieldWorld_Free(&w->forceFields);
+}
+
+void SimWorld_PlacePlayer(SimWorld* w, int p, Vector2 at) {
+    if (p < 0 || p >= SIM_PLAYERS) return;
+    Player* pl = &w->players[p];
+    pl->rect.x = at.x;
+    pl->rect.y = at.y;
+    pl->prevRect = pl->rect;
+    pl->velocity = (Vector2){0, 0};
+    pl->isJumping = false;
+    pl->contacts.valid = false;
+}
+
+void SimWorld_Respawn(SimWorld* w) {
+    for (int p = 0; p < SIM_PLAYERS; ++p) SimWorld_PlacePlayer(w, p, w->spawn[p]);
+}
+
+void SimWorld_Step(SimWorld* w, const SimInput* in) {
+    w->deathCount = 0;
+    if (w->finished) return;
+    SimClock_Tick(&w->clock);
+
+    Rectangle ground = { 0, (float)w->mapH, (float)w->mapW, w->groundDepth };
+    Player* players[SIM_PLAYERS];
+    for (int p = 0; p < SIM_PLAYERS; ++p) {
+        players[p] = &w->players[p];
+        UpdatePlayerWithInput(players[p], ground, in->players[p], SIM_TICK_DT);
+    }
+    PhaseResolvePlayersVsWorld(players, SIM_PLAYERS, &w->grid, PHASE_STEP_HEIGHT);
+
+    if (w->boxCount > 0) {
+        BoxPusher pushers[SIM_PLAYERS];
+        for (int p = 0; p < SIM_PLAYERS; ++p) pushers[p] = (BoxPusher){ players[p], in->players[p].left, in->players[p].right };
+        ForceFieldWorld_ApplyBoxes(&w->forceFields, w->boxes, w->boxCount);
+        BoxStep(w->boxes, w->boxCount, &w->boxParams, pushers, SIM_PLAYERS, &w->grid, &w->kinematics, (float)w->mapW);
+    }
+
+    // Um lago letal derruba todos de volta ao spawn
+    for (int p = 0; p < SIM_PLAYERS; ++p) {
+        LakeType hit;
+        if (LakeIndex_Query(&w->lakeIndex, players[p]->rect, kPlayerElement[p], &hit) == LAKE_VERDICT_LETHAL) {
+            w->deaths[w->deathCount++] = (SimDeath){ players[p]->rect, hit };
+            SimWorld_Respawn(w);
+            return;
+        }
+    }
+
+    TriggerWorld_Update(&w->triggers, players, SIM_PLAYERS);
+    uint32_t pressedMask = 0;
+    for (int i = 0; i < w->buttonCount; ++i) {
+        w->buttons[i].pressed = TriggerWorld_Occupancy(&w->triggers, w->buttons[i].trigger) != 0;
+        if (w->buttons[i].pressed) pressedMask |= 1u << i;
+    }
+    if (w->buttonCount > 0) SignalGraph_SetInputs(&w->signals, pressedMask);
+
+    if (w->doorsByPresence) {
+        for (int p = 0; p < SIM_PLAYERS; ++p) w->reached[p] = TriggerWorld_Contains(&w->triggers, w->doorTrigger[p], p);
+        if (TriggerWorld_Occupancy(&w->triggers, w->doorTrigger[PHASE_WATER]) == 0x7u) w->finished = true;
+    }
+    bool all = true;
+    for (int p = 0; p < SIM_PLAYERS; ++p) all = all && w->reached[p];
+    if (all) w->finished = true;
+    if (w->finished) return;
+
+    ForceFieldWorld_ApplyPlayers(&w->forceFields, players, SIM_PLAYERS);
+    for (int i = 0; i < w->platformCount; ++i) {
+        SimPlatform* pf = &w->platforms[i];
+        if (pf->body < 0) continue;
+        bool active = SignalGraph_Output(&w->signals, pf->signal);
+        PhasePlatformMoveTowards(&pf->plat, active ? PhasePlatformBottomTarget(&pf->plat) : pf->plat.startY);
+        KinematicWorld_Move(&w->kinematics, pf->body, pf->plat.rect, players, SIM_PLAYERS);
+    }
+}
+
+static uint32_t HashBytes(uint32_t h, const void* data, size_t size) {
+    const unsigned char* b = (const unsigned char*)data;
+    for (size_t i = 0; i < size; ++i) { h ^= b[i]; h *= 16777619u; }
+    return h;
+}
+
+uint32_t SimWorld_Hash(const SimWorld* w) {
+    uint32_t h = 2166136261u;
+    h = HashBytes(h, &w->clock.ticks, sizeof(w->clock.ticks));
+    for (int p = 0; p < SIM_PLAYERS; ++p) {
+        const Player* pl = &w->players[p];
+        float body[6] = { pl->rect.x, pl->rect.y, pl->rect.width, pl->rect.height, pl->velocity.x, pl->velocity.y };
+        unsigned char flags[2] = { (unsigned char)pl->isJumping, (unsigned char)w->reached[p] };
+        h = HashBytes(h, body, sizeof(body));
+        h = HashBytes(h, flags, sizeof(flags));
+    }
+    // Mapa cooperativo: caixas, barra/elevadores, botões e campos (vazios no mapa de portas)
+    for (int b = 0; b < w->boxCount; ++b) {
+        const Box* box = &w->boxes[b];
+        float body[6] = { box->rect.x, box->rect.y, box->rect.width, box->rect.height, box->velX, box->velY };
+        int rest[2] = { box->sleeping ? 1 : 0, box->stillTicks };
+        h = HashBytes(h, body, sizeof(body));
+        h = HashBytes(h, rest, sizeof(rest));
+    }
+    for (int i = 0; i < w->platformCount; ++i) {
+        const SimPlatform* pf = &w->platforms[i];
+        if (pf->body < 0) continue;
+        Vector2 v = w->kinematics.velocity[pf->body];
+        float body[4] = { pf->plat.rect.x, pf->plat.rect.y, v.x, v.y };
+        h = HashBytes(h, body, sizeof(body));
+        h = HashBytes(h, &w->kinematics.riders[pf->body], 1);
+    }
+    if (w->buttonCount > 0) {
+        uint32_t bits[2] = { w->signals.inputs, w->signals.outputs };
+        h = HashBytes(h, bits, sizeof(bits));
+    }
+    for (int i = 0; i < w->forceFields.count; ++i) {
+        unsigned char active = (unsigned char)w->forceFields.fields[i].active;
+        h = HashBytes(h, &active, 1);
+    }
+    return h;
+}
@@ -0,0 +1,114 @@
+// Núcleo de simulação sem janela: carrega o mapa e avança um tick por vez a
+// partir de um SimInput explícito. Não lê teclado, não mede tempo e não desenha;
+// a fase (front-end raylib) traduz o teclado em SimInput e desenha o estado, e
+// tools/sim_headless.c roda o mesmo núcleo sem display nem GPU. Cobre o mapa de
+// portas (fase 3) e o cooperativo (fase 4); as fases 1, 2 e 5 ainda simulam
+// dentro de FaseN().
+#ifndef SIM_WORLD_H
+#define SIM_WORLD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim_types.h"
+#include "sim_clock.h"
+#include "../player/player.h"
+#include "../objects/lake.h"
+#include "../mapa/fases/phase_common.h"
+#include "../mapa/fases/collision_grid.h"
+#include "../mapa/fases/lake_index.h"
+#include "../mapa/fases/trigger_world.h"
+#include "../mapa/fases/kinematic_world.h"
+#include "../mapa/fases/force_field.h"
+#include "../mapa/fases/signal_graph.h"
+#include "../objects/box.h"
+
+#define SIM_PLAYERS        3      // índices PHASE_EARTH, PHASE_FIRE, PHASE_WATER
+#define SIM_MAX_COLISOES   1024
+#define SIM_MAX_LAKE_SEGS  128
+#define SIM_MAX_BUTTONS    16
+#define SIM_MAX_PLATFORMS  KINEMATIC_MAX
+#define SIM_MAX_BOXES      4
+
+// Entrada de um tick: o pulo é um toque (já travado pelo front-end)
+typedef struct SimInput {
+    PlayerInput players[SIM_PLAYERS];
+} SimInput;
+
+// Morte no último tick (o front-end transforma em partículas)
+typedef struct SimDeath {
+    Rectangle at;
+    LakeType lake;
+} SimDeath;
+
+// Botão do mapa: apertado enquanto algum jogador está no gatilho dele
+typedef struct SimButton {
+    Rectangle rect;
+    char nameLower[PHASE_BUTTON_NAME_LEN];   // liga o botão aos atuadores pelo nome
+    int trigger;
+    bool pressed;
+} SimButton;
+
+// Barra/elevador: desce até o fundo da área enquanto o sinal está ligado
+typedef struct SimPlatform {
+    PhasePlatform plat;
+    int body;                    // corpo no KinematicWorld
+    int signal;                  // saída do SignalGraph
+} SimPlatform;
+
+typedef struct SimWorld {
+    int mapW, mapH;
+    Colisao colisoes[SIM_MAX_COLISOES];
+    int totalColisoes;
+    CollisionGrid grid;
+    LakeSegment lakeSegs[SIM_MAX_LAKE_SEGS];
+    int lakeSegCount;
+    LakeIndex lakeIndex;
+    Vector2 spawn[SIM_PLAYERS];
+    float groundDepth;           // chão de segurança abaixo do mapa
+    Rectangle door[SIM_PLAYERS];
+    bool reached[SIM_PLAYERS];
+    TriggerWorld triggers;       // mapa de portas: ENTER do jogador certo trava reached[]
+    bool doorsByPresence;        // mapa cooperativo: reached[] = está na porta agora
+    int doorTrigger[SIM_PLAYERS];
+    SimButton buttons[SIM_MAX_BUTTONS];
+    int buttonCount;
+    SignalGraph signals;         // botões -> plataformas
+    SimPlatform platforms[SIM_MAX_PLATFORMS];   // mapa cooperativo: 0 = barra, 1 e 2 = elevadores
+    int platformCount;
+    KinematicWorld kinematics;
+    ForceFieldWorld forceFields;
+    Box boxes[SIM_MAX_BOXES];
+    int boxCount;
+    BoxParams boxParams;
+    Player players[SIM_PLAYERS];
+    SimClock clock;              // só a contagem de ticks
+    bool finished;
+    SimDeath deaths[SIM_PLAYERS];
+    int deathCount;              // do último SimWorld_Step
+} SimWorld;
+
+// Mapa de lagos e portas (fase 3). Os jogadores saem só com o corpo
+// (PlayerInitBody); o front-end pode carregar sprites e chamar SimWorld_Respawn.
+bool SimWorld_LoadDoorsMap(SimWorld* w, const char* tmxPath, int mapW, int mapH);
+// Mapa cooperativo (fase 4): caixas com gravidade, barra e elevadores movidos por
+// botões e a corrente do ventilador. Conclui com cada um na sua porta ou com os
+// três juntos na porta da água.
+bool SimWorld_LoadCoopMap(SimWorld* w, const char* tmxPath, int mapW, int mapH);
+void SimWorld_Free(SimWorld* w);
+
+// Todos de volta ao spawn, parados
+void SimWorld_Respawn(SimWorld* w);
+// Um jogador em at, parado (replays e cenários de teste)
+void SimWorld_PlacePlayer(SimWorld* w, int p, Vector2 at);
+
+// Um tick (SIM_TICK_DT)
+void SimWorld_Step(SimWorld* w, const SimInput* in);
+
+// FNV-1a sobre o estado que importa para replay/ranking: contagem de ticks, bits
+// dos corpos dos jogadores e portas e, no mapa cooperativo, caixas (corpo, sono),
+// barra/elevadores (posição, deslocamento, quem vai em cima), botões/sinais e
+// campos de força ligados. Com SIM_FIXED_POINT deve dar o mesmo valor em qualquer
+// máquina e nível de otimização.
+uint32_t SimWorld_Hash(const SimWorld* w);
+
+#endif
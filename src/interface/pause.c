@@ -1,21 +1,73 @@
 #include "pause.h"
 #include "raylib.h"
+#include "rlgl.h"
+#include "text_cache.h"
+#include "../audio/theme.h"
+
+// Cópia do último frame da fase. Lida do backbuffer antes da troca, então é
+// sempre o frame certo, com swapchain de dois ou três buffers.
+static Texture2D gSnapshot = {0};
+static bool gPending = false;
+
+void Pause_FrameEnd(void) {
+    gPending = false;
+    if (!IsKeyPressed(KEY_ESCAPE)) return;
+
+    int w = GetRenderWidth(), h = GetRenderHeight();
+    if (w <= 0 || h <= 0) return;
+    rlDrawRenderBatchActive(); // HUD e textos ainda no lote precisam chegar ao backbuffer
+    unsigned char* pixels = rlReadScreenPixels(w, h); // já vem de cima para baixo
+    if (!pixels) return;
+
+    if (gSnapshot.id == 0 || gSnapshot.width != w || gSnapshot.height != h) {
+        if (gSnapshot.id != 0) UnloadTexture(gSnapshot);
+        Image img = { pixels, w, h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        gSnapshot = LoadTextureFromImage(img);
+    } else {
+        UpdateTexture(gSnapshot, pixels);
+    }
+    MemFree(pixels);
+    gPending = gSnapshot.id != 0;
+}
+
+bool Pause_Pending(void) {
+    return gPending;
+}
+
+void Pause_Shutdown(void) {
+    if (gSnapshot.id != 0) UnloadTexture(gSnapshot);
+    gSnapshot = (Texture2D){0};
+    gPending = false;
+}
 
 PauseResult ShowPauseMenu(void) {
     int selected = 0; // 0=retomar,1=mapa,2=menu
+    bool frozen = gPending;
+    gPending = false;
 
     // Evita fechar imediatamente por causa do mesmo ESC que abriu o menu
  
     while (!WindowShouldClose()) {
+        // Música continua tocando durante a pausa
+        Theme_Update();
+
         BeginDrawing();
+        if (frozen) {
+            // Um único quad por frame: a fase não é redesenhada
+            Rectangle src = { 0, 0, (float)gSnapshot.width, (float)gSnapshot.height };
+            Rectangle dst = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+            DrawTexturePro(gSnapshot, src, dst, (Vector2){0, 0}, 0.0f, WHITE);
+        } else {
+            ClearBackground(BLACK);
+        }
         DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), (Color){0,0,0,180});
-        DrawText("PAUSE", GetScreenWidth()/2 - 80, GetScreenHeight()/2 - 180, 50, RAYWHITE);
+        TextCache_Draw("PAUSE", GetScreenWidth()/2 - 80, GetScreenHeight()/2 - 180, 50, RAYWHITE);
 
         const char* ops[3] = { "Retomar", "Voltar ao mapa de fases", "Voltar ao menu" };
         for (int i = 0; i < 3; i++) {
             Color c = (i == selected) ? GOLD : LIGHTGRAY;
-            DrawText(ops[i], GetScreenWidth()/2 - 220, GetScreenHeight()/2 - 60 + i*60, 40, c);
-            if (i == selected) DrawText(">", GetScreenWidth()/2 - 260, GetScreenHeight()/2 - 60 + i*60, 40, c);
+            TextCache_Draw(ops[i], GetScreenWidth()/2 - 220, GetScreenHeight()/2 - 60 + i*60, 40, c);
+            if (i == selected) TextCache_Draw(">", GetScreenWidth()/2 - 260, GetScreenHeight()/2 - 60 + i*60, 40, c);
         }
         EndDrawing();
 
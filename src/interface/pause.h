@@ -1,6 +1,8 @@
 #ifndef PAUSE_H
 #define PAUSE_H
 
+#include <stdbool.h>
+
 typedef enum {
     PAUSE_RESUME = 0,
     PAUSE_TO_MAP,
@@ -8,7 +10,15 @@ typedef enum {
 } PauseResult;
 
 // Exibe menu de pausa modal e retorna a escolha.
+// Desenha o último frame congelado (Pause_FrameEnd) em vez de redesenhar a fase.
 PauseResult ShowPauseMenu(void);
 
-#endif
+// Chamar antes de FrameCapture_Frame/EndDrawing: se ESC foi apertado neste
+// frame, copia o backbuffer já completo para a textura do pause.
+void Pause_FrameEnd(void);
+// Depois de EndDrawing: true se o frame anterior foi congelado e o menu deve abrir.
+bool Pause_Pending(void);
 
+void Pause_Shutdown(void);
+
+#endif
@@ -0,0 +1,43 @@
+#include "screen_assets.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Caminho principal e alternativo (nomes antigos) de cada arte
+static const char* kAssetPaths[SCREEN_ASSET_COUNT][2] = {
+    [SCREEN_ASSET_MENU]           = { "assets/menu/menu.png", "assets/menu/menuaed.png" },
+    [SCREEN_ASSET_MAPA_INICIAL]   = { "assets/map/mapafases/1.png", NULL },
+    [SCREEN_ASSET_MAPA_PARCIAL]   = { "assets/map/mapafases/123.png", NULL },
+    [SCREEN_ASSET_MAPA_COMPLETO]  = { "assets/map/mapafases/12345.png", NULL },
+};
+
+static Texture2D gTextures[SCREEN_ASSET_COUNT];
+static bool gTried[SCREEN_ASSET_COUNT];
+
+static void LoadAsset(ScreenAsset asset) {
+    gTried[asset] = true;
+    for (int i = 0; i < 2 && gTextures[asset].id == 0; ++i) {
+        const char* path = kAssetPaths[asset][i];
+        if (path && FileExists(path)) gTextures[asset] = LoadTexture(path);
+    }
+}
+
+void ScreenAssets_Preload(void) {
+    for (int i = 0; i < SCREEN_ASSET_COUNT; ++i) {
+        if (!gTried[i]) LoadAsset((ScreenAsset)i);
+    }
+}
+
+const Texture2D* ScreenAssets_Get(ScreenAsset asset) {
+    if (asset < 0 || asset >= SCREEN_ASSET_COUNT) asset = SCREEN_ASSET_MENU;
+    // Uma falha não é repetida a cada visita: fica a textura vazia (id 0)
+    if (!gTried[asset]) LoadAsset(asset);
+    return &gTextures[asset];
+}
+
+void ScreenAssets_Shutdown(void) {
+    for (int i = 0; i < SCREEN_ASSET_COUNT; ++i) {
+        if (gTextures[i].id > 0) UnloadTexture(gTextures[i]);
+        gTextures[i] = (Texture2D){0};
+        gTried[i] = false;
+    }
+}
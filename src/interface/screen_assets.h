@@ -0,0 +1,23 @@
+// Artes de tela cheia do menu e do mapa de fases: carregadas uma vez e mantidas
+// durante todo o processo, para que as trocas menu <-> mapa <-> fase não decodifiquem PNGs.
+#ifndef SCREEN_ASSETS_H
+#define SCREEN_ASSETS_H
+
+#include "raylib.h"
+
+typedef enum {
+    SCREEN_ASSET_MENU = 0,
+    SCREEN_ASSET_MAPA_INICIAL,    // só a fase 1 liberada
+    SCREEN_ASSET_MAPA_PARCIAL,    // fases 2/3 liberadas
+    SCREEN_ASSET_MAPA_COMPLETO,   // fases 4/5 liberadas
+    SCREEN_ASSET_COUNT
+} ScreenAsset;
+
+// Carrega tudo de uma vez (chamar depois de InitWindow)
+void ScreenAssets_Preload(void);
+// Textura residente; carrega na primeira chamada se ainda não estiver em memória
+const Texture2D* ScreenAssets_Get(ScreenAsset asset);
+// Libera tudo (chamar antes de CloseWindow)
+void ScreenAssets_Shutdown(void);
+
+#endif
@@ -0,0 +1,191 @@
+#include "text_cache.h"
+#include <string.h>
+
+#define TEXT_CACHE_PROBE   8
+#define CLOCK_GLYPHS       "0123456789:. "
+#define CLOCK_GLYPH_COUNT  13
+#define CLOCK_MAX_SIZES    4
+#define CLOCK_MAX_LEN      16
+
+typedef struct {
+    bool used;
+    unsigned int hash;
+    unsigned int fontId;
+    float fontSize;
+    float spacing;
+    char text[TEXT_CACHE_MAX_TEXT];
+    Texture2D tex;
+    unsigned int lastUse;
+} TextCacheEntry;
+
+typedef struct {
+    int fontSize;
+    Texture2D tex;
+    Rectangle src[CLOCK_GLYPH_COUNT];
+    float advance[CLOCK_GLYPH_COUNT];
+    float spacing;
+    // Layout do último frame: só é refeito a partir do primeiro dígito alterado
+    char last[CLOCK_MAX_LEN];
+    int glyph[CLOCK_MAX_LEN];
+    float pos[CLOCK_MAX_LEN];
+} ClockStrip;
+
+static TextCacheEntry gEntries[TEXT_CACHE_SLOTS];
+static ClockStrip gClocks[CLOCK_MAX_SIZES];
+static int gClockCount = 0;
+static unsigned int gUseTick = 0;
+
+static unsigned int HashText(const char* text, unsigned int fontId, float fontSize) {
+    unsigned int h = 2166136261u; // FNV-1a
+    for (const unsigned char* p = (const unsigned char*)text; *p; ++p) { h ^= *p; h *= 16777619u; }
+    h ^= fontId;            h *= 16777619u;
+    h ^= (unsigned int)(fontSize * 16.0f); h *= 16777619u;
+    return h;
+}
+
+static void ReleaseEntry(TextCacheEntry* e) {
+    if (e->used && e->tex.id != 0) UnloadTexture(e->tex);
+    memset(e, 0, sizeof(*e));
+}
+
+static const TextCacheEntry* Lookup(Font font, const char* text, float fontSize, float spacing) {
+    unsigned int fontId = font.texture.id;
+    unsigned int h = HashText(text, fontId, fontSize);
+    TextCacheEntry* victim = NULL;
+    for (int i = 0; i < TEXT_CACHE_PROBE; ++i) {
+        TextCacheEntry* e = &gEntries[(h + (unsigned int)i) % TEXT_CACHE_SLOTS];
+        if (e->used && e->hash == h && e->fontId == fontId && e->fontSize == fontSize &&
+            e->spacing == spacing && strcmp(e->text, text) == 0) {
+            e->lastUse = ++gUseTick;
+            return e;
+        }
+        if (!e->used) { if (!victim || victim->used) victim = e; }
+        else if (!victim || (victim->used && e->lastUse < victim->lastUse)) victim = e;
+    }
+
+    // Conteúdo novo: rasteriza uma vez (em branco, a cor vem do tint) e descarta o mais antigo
+    ReleaseEntry(victim);
+    Image img = ImageTextEx(font, text, fontSize, spacing, WHITE);
+    if (img.data == NULL) return NULL;
+    victim->tex = LoadTextureFromImage(img);
+    UnloadImage(img);
+    if (victim->tex.id == 0) return NULL;
+    victim->used = true;
+    victim->hash = h;
+    victim->fontId = fontId;
+    victim->fontSize = fontSize;
+    victim->spacing = spacing;
+    strncpy(victim->text, text, TEXT_CACHE_MAX_TEXT - 1);
+    victim->text[TEXT_CACHE_MAX_TEXT - 1] = '\0';
+    victim->lastUse = ++gUseTick;
+    return victim;
+}
+
+void TextCache_DrawEx(Font font, const char* text, Vector2 pos, float fontSize, float spacing, Color tint) {
+    if (!text || !text[0]) return;
+    if (strlen(text) >= TEXT_CACHE_MAX_TEXT) { DrawTextEx(font, text, pos, fontSize, spacing, tint); return; }
+    const TextCacheEntry* e = Lookup(font, text, fontSize, spacing);
+    if (!e) { DrawTextEx(font, text, pos, fontSize, spacing, tint); return; }
+    DrawTexture(e->tex, (int)pos.x, (int)pos.y, tint);
+}
+
+void TextCache_Draw(const char* text, int x, int y, int fontSize, Color color) {
+    // Mesmo espaçamento que DrawText usa com a fonte padrão (base de 10px)
+    if (fontSize < 10) fontSize = 10;
+    int spacing = fontSize / 10;
+    TextCache_DrawEx(GetFontDefault(), text, (Vector2){ (float)x, (float)y }, (float)fontSize, (float)spacing, color);
+}
+
+static ClockStrip* GetClockStrip(int fontSize) {
+    for (int i = 0; i < gClockCount; ++i) if (gClocks[i].fontSize == fontSize) return &gClocks[i];
+    if (gClockCount >= CLOCK_MAX_SIZES) return NULL;
+
+    ClockStrip* c = &gClocks[gClockCount];
+    memset(c, 0, sizeof(*c));
+    c->fontSize = fontSize;
+    c->spacing = (float)(fontSize / 10);
+
+    Image glyphs[CLOCK_GLYPH_COUNT];
+    int stripW = 0, stripH = 0;
+    for (int g = 0; g < CLOCK_GLYPH_COUNT; ++g) {
+        char s[2] = { CLOCK_GLYPHS[g], '\0' };
+        glyphs[g] = ImageText(s, fontSize, WHITE);
+        c->advance[g] = (float)MeasureText(s, fontSize);
+        stripW += glyphs[g].width;
+        if (glyphs[g].height > stripH) stripH = glyphs[g].height;
+    }
+    Image strip = GenImageColor(stripW > 0 ? stripW : 1, stripH > 0 ? stripH : 1, BLANK);
+    int x = 0;
+    for (int g = 0; g < CLOCK_GLYPH_COUNT; ++g) {
+        Rectangle src = { 0, 0, (float)glyphs[g].width, (float)glyphs[g].height };
+        c->src[g] = (Rectangle){ (float)x, 0, src.width, src.height };
+        ImageDraw(&strip, glyphs[g], src, c->src[g], WHITE);
+        x += glyphs[g].width;
+        UnloadImage(glyphs[g]);
+    }
+    c->tex = LoadTextureFromImage(strip);
+    UnloadImage(strip);
+    if (c->tex.id == 0) return NULL;
+    gClockCount++;
+    return c;
+}
+
+static void AppendInt(char* out, int* n, long value, int minDigits) {
+    char tmp[16]; int len = 0;
+    do { tmp[len++] = (char)('0' + value % 10); value /= 10; } while (value > 0 && len < 15);
+    while (len < minDigits) tmp[len++] = '0';
+    while (len > 0 && *n < CLOCK_MAX_LEN - 1) out[(*n)++] = tmp[--len];
+}
+
+// Mesmo texto de "%02d:%05.2f" (ou "%05.2f"), montado com aritmética inteira
+static void FormatClock(char* out, float seconds, bool withMinutes) {
+    if (seconds < 0.0f) seconds = 0.0f;
+    long centis = (long)(seconds * 100.0f + 0.5f);
+    long whole = centis / 100;
+    int n = 0;
+    if (withMinutes) {
+        AppendInt(out, &n, whole / 60, 2);
+        out[n++] = ':';
+        whole %= 60;
+    }
+    AppendInt(out, &n, whole, 2);
+    if (n < CLOCK_MAX_LEN - 3) {
+        out[n++] = '.';
+        out[n++] = (char)('0' + (centis % 100) / 10);
+        out[n++] = (char)('0' + centis % 10);
+    }
+    out[n] = '\0';
+}
+
+void TextCache_DrawClock(float seconds, bool withMinutes, int x, int y, int fontSize, Color color) {
+    char text[CLOCK_MAX_LEN];
+    FormatClock(text, seconds, withMinutes);
+    if (fontSize < 10) fontSize = 10;
+    ClockStrip* c = GetClockStrip(fontSize);
+    if (!c) { DrawText(text, x, y, fontSize, color); return; }
+
+    int first = 0;
+    while (text[first] && text[first] == c->last[first]) first++;
+    if (text[first] != '\0' || c->last[first] != '\0') {
+        float pos = first > 0 ? c->pos[first - 1] + c->advance[c->glyph[first - 1]] + c->spacing : 0.0f;
+        for (int i = first; text[i]; ++i) {
+            const char* g = strchr(CLOCK_GLYPHS, text[i]);
+            c->glyph[i] = g ? (int)(g - CLOCK_GLYPHS) : CLOCK_GLYPH_COUNT - 1;
+            c->pos[i] = pos;
+            pos += c->advance[c->glyph[i]] + c->spacing;
+        }
+        memcpy(c->last, text, sizeof(text));
+    }
+
+    for (int i = 0; c->last[i]; ++i) {
+        DrawTextureRec(c->tex, c->src[c->glyph[i]], (Vector2){ x + c->pos[i], (float)y }, color);
+    }
+}
+
+void TextCache_Clear(void) {
+    for (int i = 0; i < TEXT_CACHE_SLOTS; ++i) ReleaseEntry(&gEntries[i]);
+    for (int i = 0; i < gClockCount; ++i) if (gClocks[i].tex.id != 0) UnloadTexture(gClocks[i].tex);
+    memset(gClocks, 0, sizeof(gClocks));
+    gClockCount = 0;
+    gUseTick = 0;
+}
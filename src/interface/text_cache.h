@@ -0,0 +1,23 @@
+// Cache de textos renderizados: cada (texto, fonte, tamanho) vira uma textura
+// uma única vez e depois é desenhado como um quad, colorido pelo tint.
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define TEXT_CACHE_SLOTS    128
+#define TEXT_CACHE_MAX_TEXT 128
+
+// Substituto direto de DrawText (fonte padrão)
+void TextCache_Draw(const char* text, int x, int y, int fontSize, Color color);
+void TextCache_DrawEx(Font font, const char* text, Vector2 pos, float fontSize, float spacing, Color tint);
+
+// Cronômetro do HUD ("MM:SS.cc", ou "SS.cc" sem minutos) montado a partir de uma
+// faixa de glifos em cache; só reposiciona os dígitos que mudaram desde o último frame.
+void TextCache_DrawClock(float seconds, bool withMinutes, int x, int y, int fontSize, Color color);
+
+// Libera todas as texturas (chamar antes de CloseWindow)
+void TextCache_Clear(void);
+
+#endif
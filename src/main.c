@@ -4,17 +4,56 @@
 #include "mapa/mapa_fases.h"
 #include "ranking/ranking.h"
 #include "audio/theme.h"
+#include "render/render_scale.h"
+#include "render/render_stats.h"
+#include "render/frame_capture.h"
+#include "interface/text_cache.h"
+#include "interface/screen_assets.h"
+#include "interface/pause.h"
+#include "structure/aabb_soa.h"
+#include <stdlib.h>
+#include <string.h>
 
-int main(void)
+// Opções de resolução interna: --render-scale=50..100, --render-dynamic, --render-bilinear
+// Captura: --capture=png|qoi|y4m (grava desde o início), --capture-dir=PASTA
+static bool LerOpcoesRender(int argc, char** argv) {
+    bool capturar = false;
+    FrameCaptureFormat formato = FRAME_CAPTURE_PNG;
+    const char* pasta = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--render-scale=", 15) == 0) {
+            RenderScale_SetScale(atoi(argv[i] + 15) / 100.0f);
+        } else if (strcmp(argv[i], "--render-dynamic") == 0) {
+            RenderScale_SetDynamic(true, 60);
+        } else if (strcmp(argv[i], "--render-bilinear") == 0) {
+            RenderScale_SetFilter(RENDER_FILTER_BILINEAR);
+        } else if (strncmp(argv[i], "--capture=", 10) == 0) {
+            const char* fmt = argv[i] + 10;
+            formato = strcmp(fmt, "y4m") == 0 ? FRAME_CAPTURE_Y4M : (strcmp(fmt, "qoi") == 0 ? FRAME_CAPTURE_QOI : FRAME_CAPTURE_PNG);
+            capturar = true;
+        } else if (strncmp(argv[i], "--capture-dir=", 14) == 0) {
+            pasta = argv[i] + 14;
+        }
+    }
+    FrameCapture_Configure(formato, pasta, 60);
+    return capturar;
+}
+
+int main(int argc, char** argv)
 {
     const int screenWidth = 1920;
     const int screenHeight = 1080;
 
+    AabbSoa_SelectBackend(); // antes de a fase 3 abrir a thread de simulação
     InitWindow(screenWidth, screenHeight, "Elements");
     SetExitKey(0);
     SetTargetFPS(60);
+    bool capturar = LerOpcoesRender(argc, argv);
+    RenderScale_Init();
+    if (capturar) FrameCapture_Start();
     Ranking_Init();
     Theme_Init();
+    ScreenAssets_Preload();
 
     bool rodando = true;
 
@@ -38,7 +77,13 @@ int main(void)
             continue;
     }
 
+    FrameCapture_Stop();
     Theme_Shutdown();
+    RenderScale_Shutdown();
+    RenderStats_Shutdown();
+    TextCache_Clear();
+    ScreenAssets_Shutdown();
+    Pause_Shutdown();
 
     CloseWindow();
     return 0;
@@ -0,0 +1,284 @@
+#include "collision_grid.h"
+#include "../../game/sim_rect.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void CellRange(const CollisionGrid* g, Rectangle r, int* x0, int* y0, int* x1, int* y1) {
+    *x0 = (int)floorf((r.x - g->originX) / g->cellSize);
+    *y0 = (int)floorf((r.y - g->originY) / g->cellSize);
+    *x1 = (int)floorf((r.x + r.width - g->originX) / g->cellSize);
+    *y1 = (int)floorf((r.y + r.height - g->originY) / g->cellSize);
+    if (*x0 < 0) *x0 = 0;
+    if (*y0 < 0) *y0 = 0;
+    if (*x1 >= g->cols) *x1 = g->cols - 1;
+    if (*y1 >= g->rows) *y1 = g->rows - 1;
+}
+
+static bool OnTileGrid(float v) {
+    float t = v / COLLISION_TILE_SIZE;
+    return fabsf(t - roundf(t)) < 1e-3f;
+}
+
+static bool TileAligned(Rectangle r) {
+    return r.x >= 0 && r.y >= 0 && r.width > 0 && r.height > 0 &&
+           OnTileGrid(r.x) && OnTileGrid(r.y) && OnTileGrid(r.width) && OnTileGrid(r.height);
+}
+
+// Faixa de tiles de r, já limitada ao mapa. exact: só tiles cujo interior encosta
+// no interior de r (r com área); senão também os que só tocam a borda, como CellRange.
+static bool TileRange(const CollisionGrid* g, Rectangle r, bool exact, int* x0, int* y0, int* x1, int* y1) {
+    if (g->tileCols <= 0 || r.width < 0 || r.height < 0) return false;
+    if (exact && (r.width <= 0 || r.height <= 0)) return false;
+    *x0 = (int)floorf(r.x / COLLISION_TILE_SIZE);
+    *y0 = (int)floorf(r.y / COLLISION_TILE_SIZE);
+    if (exact) {
+        *x1 = (int)ceilf((r.x + r.width) / COLLISION_TILE_SIZE) - 1;
+        *y1 = (int)ceilf((r.y + r.height) / COLLISION_TILE_SIZE) - 1;
+    } else {
+        *x1 = (int)floorf((r.x + r.width) / COLLISION_TILE_SIZE);
+        *y1 = (int)floorf((r.y + r.height) / COLLISION_TILE_SIZE);
+    }
+    if (*x0 < 0) *x0 = 0;
+    if (*y0 < 0) *y0 = 0;
+    if (*x1 >= g->tileCols) *x1 = g->tileCols - 1;
+    if (*y1 >= g->tileRows) *y1 = g->tileRows - 1;
+    return *x0 <= *x1 && *y0 <= *y1;
+}
+
+// Bits de uma linha de tiles entre x0 e x1 dentro da palavra w
+static uint64_t RowBits(const CollisionGrid* g, int y, int w, int x0, int x1) {
+    uint64_t bits = g->tileSolid[y * g->tileWords + w];
+    int lo = x0 - w * 64, hi = x1 - w * 64;
+    if (lo > 0) bits &= ~0ull << lo;
+    if (hi < 63) bits &= ~0ull >> (63 - hi);
+    return bits;
+}
+
+static void SetTiles(CollisionGrid* g, Rectangle r, int owner) {
+    int x0, y0, x1, y1;
+    if (!TileRange(g, r, true, &x0, &y0, &x1, &y1)) return;
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            uint64_t bit = 1ull << (x & 63);
+            if (owner >= 0) g->tileSolid[y * g->tileWords + (x >> 6)] |= bit;
+            else            g->tileSolid[y * g->tileWords + (x >> 6)] &= ~bit;
+            g->tileOwner[y * g->tileCols + x] = owner;
+        }
+    }
+}
+
+// Só entra no mapa de tiles quem não divide tile com outro: cada tile tem um dono
+static void BuildTiles(CollisionGrid* g) {
+    float maxX = 0, maxY = 0;
+    for (int i = 0; i < g->count; ++i) {
+        Rectangle r = g->rects[i].rect;
+        if (!TileAligned(r)) continue;
+        if (r.x + r.width > maxX) maxX = r.x + r.width;
+        if (r.y + r.height > maxY) maxY = r.y + r.height;
+    }
+    if (maxX <= 0 || maxY <= 0) return;
+    int cols = (int)roundf(maxX / COLLISION_TILE_SIZE);
+    int rows = (int)roundf(maxY / COLLISION_TILE_SIZE);
+    int words = (cols + 63) / 64;
+    g->tileSolid = (uint64_t*)calloc((size_t)rows * words, sizeof(uint64_t));
+    g->tileOwner = (int*)malloc((size_t)rows * cols * sizeof(int));
+    if (!g->tileSolid || !g->tileOwner) {
+        free(g->tileSolid); free(g->tileOwner);
+        g->tileSolid = NULL; g->tileOwner = NULL;
+        return;
+    }
+    for (int t = 0; t < rows * cols; ++t) g->tileOwner[t] = -1;
+    g->tileCols = cols;
+    g->tileRows = rows;
+    g->tileWords = words;
+
+    for (int i = 0; i < g->count; ++i) {
+        Rectangle r = g->rects[i].rect;
+        if (!TileAligned(r)) continue;
+        int x0, y0, x1, y1;
+        if (!TileRange(g, r, true, &x0, &y0, &x1, &y1)) continue;
+        bool vacant = true;
+        for (int y = y0; y <= y1 && vacant; ++y)
+            for (int x = x0; x <= x1 && vacant; ++x)
+                if (g->tileOwner[y * cols + x] >= 0) vacant = false;
+        if (!vacant) continue;
+        SetTiles(g, r, i);
+        g->onTiles[i] = 1;
+    }
+}
+
+bool CollisionGrid_Build(CollisionGrid* g, Colisao* rects, int count, float cellSize) {
+    memset(g, 0, sizeof(*g));
+    g->rects = rects;
+    g->count = count;
+    g->cellSize = cellSize > 1.0f ? cellSize : COLLISION_GRID_CELL;
+    if (count <= 0) return true;
+
+    float minX = rects[0].rect.x, minY = rects[0].rect.y;
+    float maxX = minX + rects[0].rect.width, maxY = minY + rects[0].rect.height;
+    for (int i = 1; i < count; ++i) {
+        Rectangle r = rects[i].rect;
+        if (r.x < minX) minX = r.x;
+        if (r.y < minY) minY = r.y;
+        if (r.x + r.width > maxX) maxX = r.x + r.width;
+        if (r.y + r.height > maxY) maxY = r.y + r.height;
+    }
+    g->originX = minX;
+    g->originY = minY;
+    g->cols = (int)((maxX - minX) / g->cellSize) + 1;
+    g->rows = (int)((maxY - minY) / g->cellSize) + 1;
+    int cells = g->cols * g->rows;
+
+    g->cellStart = (int*)calloc((size_t)cells + 1, sizeof(int));
+    g->dynamic = (unsigned char*)calloc((size_t)count, 1);
+    g->dynamicList = (int*)malloc((size_t)count * sizeof(int));
+    g->stamp = (unsigned int*)calloc((size_t)count, sizeof(unsigned int));
+    g->onTiles = (unsigned char*)calloc((size_t)count, 1);
+    if (!g->cellStart || !g->dynamic || !g->dynamicList || !g->stamp || !g->onTiles) { CollisionGrid_Free(g); return false; }
+    BuildTiles(g);
+
+    // Duas passadas: conta por célula, depois preenche (índices crescentes em cada célula)
+    int total = 0;
+    for (int i = 0; i < count; ++i) {
+        if (g->onTiles[i]) continue;
+        int x0, y0, x1, y1;
+        CellRange(g, rects[i].rect, &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x) { g->cellStart[y * g->cols + x + 1]++; total++; }
+    }
+    for (int c = 0; c < cells; ++c) g->cellStart[c + 1] += g->cellStart[c];
+
+    g->cellItems = (int*)malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    int* fill = (int*)malloc((size_t)cells * sizeof(int));
+    if (!g->cellItems || !fill) { free(fill); CollisionGrid_Free(g); return false; }
+    memcpy(fill, g->cellStart, (size_t)cells * sizeof(int));
+    for (int i = 0; i < count; ++i) {
+        if (g->onTiles[i]) continue;
+        int x0, y0, x1, y1;
+        CellRange(g, rects[i].rect, &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x) g->cellItems[fill[y * g->cols + x]++] = i;
+    }
+    free(fill);
+
+    if (!AabbSoa_Init(&g->cellBounds, total)) { CollisionGrid_Free(g); return false; }
+    for (int k = 0; k < total; ++k) AabbSoa_Set(&g->cellBounds, k, rects[g->cellItems[k]].rect);
+    return true;
+}
+
+void CollisionGrid_Free(CollisionGrid* g) {
+    free(g->cellStart);
+    free(g->cellItems);
+    free(g->dynamic);
+    free(g->dynamicList);
+    free(g->stamp);
+    free(g->onTiles);
+    free(g->tileSolid);
+    free(g->tileOwner);
+    AabbSoa_Free(&g->cellBounds);
+    memset(g, 0, sizeof(*g));
+}
+
+static void RefreshDynamicBounds(CollisionGrid* g) {
+    if (g->dynamicCount <= 0) { g->dynamicBounds = (Rectangle){0}; return; }
+    Rectangle r = g->rects[g->dynamicList[0]].rect;
+    float minX = r.x, minY = r.y, maxX = r.x + r.width, maxY = r.y + r.height;
+    for (int d = 1; d < g->dynamicCount; ++d) {
+        r = g->rects[g->dynamicList[d]].rect;
+        if (r.x < minX) minX = r.x;
+        if (r.y < minY) minY = r.y;
+        if (r.x + r.width > maxX) maxX = r.x + r.width;
+        if (r.y + r.height > maxY) maxY = r.y + r.height;
+    }
+    g->dynamicBounds = (Rectangle){ minX, minY, maxX - minX, maxY - minY };
+}
+
+void CollisionGrid_SetDynamic(CollisionGrid* g, int index) {
+    if (!g->dynamic || index < 0 || index >= g->count || g->dynamic[index]) return;
+    g->dynamic[index] = 1;
+    g->dynamicList[g->dynamicCount++] = index;
+    if (g->onTiles[index]) { // sai do mapa de tiles: a posição vai mudar
+        SetTiles(g, g->rects[index].rect, -1);
+        g->onTiles[index] = 0;
+    }
+    RefreshDynamicBounds(g);
+    g->dynamicEpoch++;
+}
+
+void CollisionGrid_MoveDynamic(CollisionGrid* g, int index, Rectangle to) {
+    if (index < 0 || index >= g->count) return;
+    g->rects[index].rect = to;
+    if (g->dynamic && g->dynamic[index]) RefreshDynamicBounds(g);
+    g->dynamicEpoch++;
+}
+
+int CollisionGrid_Query(CollisionGrid* g, Rectangle area, int* out, int cap) {
+    if (g->count <= 0 || !g->cellStart) return 0;
+    if (++g->queryId == 0) { // contador deu a volta
+        memset(g->stamp, 0, (size_t)g->count * sizeof(unsigned int));
+        g->queryId = 1;
+    }
+
+    int n = 0;
+    int x0, y0, x1, y1;
+    // Tiles: só os bits da faixa que a área cobre; o dono ainda passa pelo mesmo
+    // teste estrito das células (a faixa inclui tiles que só tocam a borda)
+    if (TileRange(g, area, false, &x0, &y0, &x1, &y1)) {
+        for (int y = y0; y <= y1; ++y) {
+            for (int w = x0 >> 6; w <= x1 >> 6; ++w) {
+                uint64_t bits = RowBits(g, y, w, x0, x1);
+                while (bits) {
+                    int x = w * 64 + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    int i = g->tileOwner[y * g->tileCols + x];
+                    if (i < 0 || g->stamp[i] == g->queryId) continue;
+                    g->stamp[i] = g->queryId;
+                    if (n < cap && SimRectsOverlap(area, g->rects[i].rect)) out[n++] = i;
+                }
+            }
+        }
+    }
+    CellRange(g, area, &x0, &y0, &x1, &y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int c = y * g->cols + x;
+            for (int k = g->cellStart[c]; k < g->cellStart[c + 1]; k += 32) {
+                int len = g->cellStart[c + 1] - k;
+                unsigned int hits = AabbSoa_Overlap(&g->cellBounds, k, len < 32 ? len : 32, area);
+                while (hits) {
+                    int bit = __builtin_ctz(hits);
+                    hits &= hits - 1;
+                    int i = g->cellItems[k + bit];
+                    if (g->stamp[i] == g->queryId || g->dynamic[i]) continue;
+                    g->stamp[i] = g->queryId;
+                    if (n < cap) out[n++] = i;
+                }
+            }
+        }
+    }
+    bool nearDynamic = g->dynamicCount > 0 && SimRectsOverlap(area, g->dynamicBounds);
+    for (int d = 0; nearDynamic && d < g->dynamicCount; ++d) {
+        int i = g->dynamicList[d];
+        if (n < cap && SimRectsOverlap(area, g->rects[i].rect)) out[n++] = i;
+    }
+
+    // Inserção: poucas entradas por consulta
+    for (int a = 1; a < n; ++a) {
+        int v = out[a], b = a - 1;
+        while (b >= 0 && out[b] > v) { out[b + 1] = out[b]; --b; }
+        out[b + 1] = v;
+    }
+    return n;
+}
+
+bool CollisionGrid_AreaSolid(CollisionGrid* g, Rectangle area) {
+    int x0, y0, x1, y1;
+    if (TileRange(g, area, true, &x0, &y0, &x1, &y1)) {
+        for (int y = y0; y <= y1; ++y)
+            for (int w = x0 >> 6; w <= x1 >> 6; ++w)
+                if (RowBits(g, y, w, x0, x1)) return true;
+    }
+    int any;
+    return CollisionGrid_Query(g, area, &any, 1) > 0;
+}
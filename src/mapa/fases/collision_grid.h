@@ -0,0 +1,65 @@
+#ifndef COLLISION_GRID_H
+#define COLLISION_GRID_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../game/sim_types.h"
+#include "phase_common.h"
+#include "../../structure/aabb_soa.h"
+
+#define COLLISION_GRID_CELL       64.0f   // px por célula
+#define COLLISION_GRID_QUERY_MAX  256     // índices devolvidos por consulta
+#define COLLISION_TILE_SIZE       27.0f   // tile dos mapas do Tiled
+
+// Grade uniforme sobre as colisões estáticas da fase, montada uma vez na carga
+// (células em formato CSR: cellStart/cellItems). Retângulos que se movem
+// (barras, elevadores) ficam fora da grade e são testados à parte a cada consulta,
+// lendo sempre a posição atual no vetor de colisões da fase; a caixa que envolve
+// todos eles (dynamicBounds) deixa a consulta pular essa lista quando está longe.
+// Os limites dos estáticos são copiados na ordem de cellItems para um AabbSoa,
+// então cada célula é testada em blocos com SIMD e o resultado é uma máscara.
+// Estáticos alinhados aos tiles de 27px não entram nas células: viram bits num
+// mapa de solidez (uma linha de palavras de 64 bits por linha de tiles) e cada
+// tile lembra qual retângulo o ocupa. A consulta lê só os tiles que a área cobre,
+// então o custo depende do tamanho da área, não de quantas colisões o mapa tem.
+typedef struct CollisionGrid {
+    Colisao* rects;           // vetor da fase (não é copiado)
+    int count;
+    float cellSize;
+    float originX, originY;
+    int cols, rows;
+    int* cellStart;           // cols*rows + 1
+    int* cellItems;
+    AabbSoa cellBounds;       // paralelo a cellItems (entrada k = rects[cellItems[k]])
+    unsigned char* dynamic;   // 1 = fora da grade
+    int* dynamicList;
+    int dynamicCount;
+    Rectangle dynamicBounds;  // união dos dinâmicos, refeita a cada MoveDynamic
+    unsigned int dynamicEpoch; // muda a cada SetDynamic/MoveDynamic (validade de caches)
+    int tileCols, tileRows;
+    int tileWords;            // palavras de 64 bits por linha de tiles
+    uint64_t* tileSolid;      // tileRows * tileWords
+    int* tileOwner;           // retângulo dono de cada tile (-1 = vazio)
+    unsigned char* onTiles;   // 1 = retângulo está no mapa de tiles, não nas células
+    unsigned int* stamp;      // evita repetir um retângulo presente em várias células
+    unsigned int queryId;
+} CollisionGrid;
+
+bool CollisionGrid_Build(CollisionGrid* g, Colisao* rects, int count, float cellSize);
+void CollisionGrid_Free(CollisionGrid* g);
+
+// Tira um retângulo da grade: passa a ser testado sempre, onde quer que esteja
+void CollisionGrid_SetDynamic(CollisionGrid* g, int index);
+
+// Move um retângulo dinâmico (escreve no vetor da fase e atualiza dynamicBounds).
+// Dinâmicos devem ser movidos sempre por aqui, não escrevendo direto no vetor.
+void CollisionGrid_MoveDynamic(CollisionGrid* g, int index, Rectangle to);
+
+// Índices (em ordem crescente) dos retângulos que tocam area; a ordem é a mesma
+// do laço antigo sobre todas as colisões, então a resolução dá o mesmo resultado.
+int CollisionGrid_Query(CollisionGrid* g, Rectangle area, int* out, int cap);
+
+// "Tem algo sólido aqui?" sem montar a lista: tiles primeiro (só bits), depois o resto
+bool CollisionGrid_AreaSolid(CollisionGrid* g, Rectangle area);
+
+#endif
@@ -6,9 +6,23 @@
 #include "../../objects/fan.h"
 #include "../../interface/pause.h"
 #include "../../game/game.h"
+#include "../../game/sim_clock.h"
+#include "../../game/sim_input.h"
 #include "../../ranking/ranking.h"
 #include "../../audio/theme.h"
+#include "../../render/render_scale.h"
+#include "../../render/particles.h"
+#include "../../render/frame_capture.h"
+#include "../../interface/text_cache.h"
 #include "phase_common.h"
+#include "lake_renderer.h"
+#include "lake_index.h"
+#include "trigger_world.h"
+#include "kinematic_world.h"
+#include "force_field.h"
+#include "signal_graph.h"
+#include "tilemap_renderer.h"
+#include "collision_grid.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -55,18 +69,6 @@ static void DrawPlatformTexture(Texture2D tex, Rectangle rect) {
         DrawRectangleRec(rect, GRAY);
 }
 
-static int FindCollisionIndex(Rectangle rect, const Colisao* col, int colCount) {
-    for (int i = 0; i < colCount; ++i) {
-        Rectangle r = col[i].rect;
-        if (fabsf(r.x - rect.x) > 0.5f) continue;
-        if (fabsf(r.y - rect.y) > 0.5f) continue;
-        if (fabsf(r.width - rect.width) > 0.5f) continue;
-        if (fabsf(r.height - rect.height) > 0.5f) continue;
-        return i;
-    }
-    return -1;
-}
-
 static void DrawFanSprite(Rectangle rect, bool active, const Texture2D* onFrames, int onCount, Texture2D offTex, int animFrame) {
     Texture2D tex = offTex;
     bool usingOffTex = !active && offTex.id != 0;
@@ -91,14 +93,13 @@ static void DrawFanSprite(Rectangle rect, bool active, const Texture2D* onFrames
 
 bool Fase2(void) {
     const char* tmxPath = "assets/maps/fase2/fase2.tmx";
-    Texture2D mapTexture = LoadTexture("assets/maps/fase2/fase2.png");
+    PhaseBackground background;
+    PhaseBackgroundLoad(&background, tmxPath, "assets/maps/fase2/fase2.png");
 
 
     Colisao colisoes[MAX_COLISOES];
     int totalColisoes = 0;
     AddCollisionGroup(tmxPath, "colisao", colisoes, &totalColisoes, MAX_COLISOES);
-    AddCollisionGroup(tmxPath, "barra1", colisoes, &totalColisoes, MAX_COLISOES);
-    AddCollisionGroup(tmxPath, "barra2", colisoes, &totalColisoes, MAX_COLISOES);
 
     LakeSegment lakeSegs[MAX_LAKE_SEGS]; int lakeSegCount = 0;
     AddLakeSegments(tmxPath, "aguaesquerda", LAKE_WATER, PART_LEFT,   lakeSegs, &lakeSegCount, MAX_LAKE_SEGS);
@@ -114,11 +115,12 @@ bool Fase2(void) {
     AddLakeSegments(tmxPath, "venenomeio",     LAKE_POISON, PART_MIDDLE, lakeSegs, &lakeSegCount, MAX_LAKE_SEGS);
     AddLakeSegments(tmxPath, "venenodireita",  LAKE_POISON, PART_RIGHT,  lakeSegs, &lakeSegCount, MAX_LAKE_SEGS);
 
-    LakeAnimFrames animAgua={0}, animFogo={0}, animTerra={0}, animAcido={0};
-    LoadLakeSet_Agua(&animAgua);
-    LoadLakeSet_Fogo(&animFogo);
-    LoadLakeSet_Terra(&animTerra);
-    LoadLakeSet_Acido(&animAcido);
+    LakeRenderer lakeRenderer;
+    LakeRendererLoad(&lakeRenderer, lakeSegs, lakeSegCount, 0.12f);
+    LakeIndex lakeIndex;
+    LakeIndex_Build(&lakeIndex, lakeSegs, lakeSegCount);
+    Particles_Reset();
+    for (int i = 0; i < lakeSegCount; ++i) Particles_AddLakeEmitter(lakeSegs[i].rect, lakeSegs[i].type);
 
     Rectangle spawn[4];
     Vector2 spawnAgua = { 200, 800 };
@@ -185,6 +187,12 @@ bool Fase2(void) {
         }
     }
 
+    // Fiação botão -> atuador compilada uma vez a partir dos nomes dos botões
+    SignalGraph signals;
+    SignalGraph_Init(&signals, buttonCount);
+    const char* buttonNames[MAX_BUTTONS];
+    for (int i=0;i<buttonCount;i++) buttonNames[i] = buttonNamesLower[i];
+
     Fan fans1[MAX_FANS]; int fans1Count = 0;
     Rectangle fanRects[8];
     int nFan1 = ParseRectsFromGroup(tmxPath, "ventilador1", fanRects, 8);
@@ -194,6 +202,18 @@ bool Fase2(void) {
     int nFan2 = ParseRectsFromGroup(tmxPath, "ventilador2", fanRects, 8);
     for (int i=0;i<nFan2 && fans2Count<MAX_FANS;i++)
         FanInit(&fans2[fans2Count++], fanRects[i].x, fanRects[i].y, fanRects[i].width, fanRects[i].height, 0.9f);
+    int fan1Signal = SignalGraph_AddNamedOutput(&signals, SIGNAL_OR, "ventilador1", buttonNames, buttonCount);
+    int fan2Signal = SignalGraph_AddNamedOutput(&signals, SIGNAL_OR, "botao3ventilador2_marrom", buttonNames, buttonCount);
+    // Cada grupo de ventiladores vira campos de força ligados pelo sinal do grupo
+    ForceFieldWorld forceFields;
+    ForceFieldWorld_Init(&forceFields);
+    for (int i=0;i<fans1Count;i++) FanAddField(&fans1[i], &forceFields, fan1Signal);
+    for (int i=0;i<fans2Count;i++) FanAddField(&fans2[i], &forceFields, fan2Signal);
+
+    // Correntes de ar visíveis enquanto o ventilador estiver ligado
+    int fan1Emitters[MAX_FANS], fan2Emitters[MAX_FANS];
+    for (int i=0;i<fans1Count;i++) fan1Emitters[i] = Particles_AddEmitter(PARTICLE_FAN_UP, fans1[i].rect, fans1[i].rect.width / 27.0f * 10.0f);
+    for (int i=0;i<fans2Count;i++) fan2Emitters[i] = Particles_AddEmitter(PARTICLE_FAN_UP, fans2[i].rect, fans2[i].rect.width / 27.0f * 10.0f);
 
     Rectangle fanSpriteRects[16]; bool fanSpriteUsed[16]={0};
     int fanSpriteCount = ParseRectsFromGroup(tmxPath, "AnimarVentilador", fanSpriteRects, 16);
@@ -211,7 +231,8 @@ bool Fase2(void) {
     int platformCollisionIndex[MAX_PLATFORMS];
     for (int i=0;i<MAX_PLATFORMS;i++) platformCollisionIndex[i] = -1;
     Texture2D* platformTexRefs[MAX_PLATFORMS] = {0};
-    char platformControlTokens[MAX_PLATFORMS][32] = {{0}};
+    int platformSignal[MAX_PLATFORMS];
+    for (int i=0;i<MAX_PLATFORMS;i++) platformSignal[i] = -1;
     bool platformMoveDownActive[MAX_PLATFORMS] = { false };
     Rectangle platR[4];
     Rectangle rangeRect[4];
@@ -221,11 +242,13 @@ bool Fase2(void) {
         PhasePlatformInit(&platforms[platformCount], platR[0], area, 2.0f);
         platforms[platformCount].rect.y = area.y;
         platforms[platformCount].startY = area.y;
-        strncpy(platformControlTokens[platformCount], "botao4barra1_branco", sizeof(platformControlTokens[platformCount]) - 1);
+        platformSignal[platformCount] = SignalGraph_AddNamedOutput(&signals, SIGNAL_OR, "botao4barra1_branco", buttonNames, buttonCount);
         platformTexRefs[platformCount] = &barra1Tex;
         platformMoveDownActive[platformCount] = true;
-        platformCollisionIndex[platformCount] = FindCollisionIndex(platforms[platformCount].rect, colisoes, totalColisoes);
-        if (platformCollisionIndex[platformCount] >= 0) colisoes[platformCollisionIndex[platformCount]].rect = platforms[platformCount].rect;
+        if (totalColisoes < MAX_COLISOES) {
+            platformCollisionIndex[platformCount] = totalColisoes;
+            colisoes[totalColisoes++].rect = platforms[platformCount].rect;
+        }
         platformCount++;
     }
     if (ParseRectsFromGroup(tmxPath, "barra2", platR, 4) > 0 && platformCount < MAX_PLATFORMS) {
@@ -234,14 +257,24 @@ bool Fase2(void) {
         PhasePlatformInit(&platforms[platformCount], platR[0], area, 2.0f);
         platforms[platformCount].rect.y = area.y;
         platforms[platformCount].startY = area.y;
-        strncpy(platformControlTokens[platformCount], "botao5barra2_vermelho", sizeof(platformControlTokens[platformCount]) - 1);
+        platformSignal[platformCount] = SignalGraph_AddNamedOutput(&signals, SIGNAL_OR, "botao5barra2_vermelho", buttonNames, buttonCount);
         platformTexRefs[platformCount] = &barra2Tex;
         platformMoveDownActive[platformCount] = true;
-        platformCollisionIndex[platformCount] = FindCollisionIndex(platforms[platformCount].rect, colisoes, totalColisoes);
-        if (platformCollisionIndex[platformCount] >= 0) colisoes[platformCollisionIndex[platformCount]].rect = platforms[platformCount].rect;
+        if (totalColisoes < MAX_COLISOES) {
+            platformCollisionIndex[platformCount] = totalColisoes;
+            colisoes[totalColisoes++].rect = platforms[platformCount].rect;
+        }
         platformCount++;
     }
 
+    CollisionGrid grid;
+    CollisionGrid_Build(&grid, colisoes, totalColisoes, COLLISION_GRID_CELL);
+    // As barras se movem: corpos cinemáticos, fora da grade estática
+    KinematicWorld kinematics;
+    KinematicWorld_Init(&kinematics, &grid);
+    int platformBody[MAX_PLATFORMS];
+    for (int i = 0; i < platformCount; ++i) platformBody[i] = KinematicWorld_Add(&kinematics, platformCollisionIndex[i]);
+
     Texture2D fanOffTex = LoadTextureIfExists("assets/map/vento/desligado.png");
     Texture2D fanOnFrames[8]; int fanOnCount = 0;
     const char* fanPaths[] = {
@@ -268,176 +301,146 @@ bool Fase2(void) {
     earthboy.rect  = (Rectangle){ spawnTerra.x, spawnTerra.y, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT };
 
     Camera2D camera = (Camera2D){
-        .target = { mapTexture.width/2.0f, mapTexture.height/2.0f },
+        .target = { background.width/2.0f, background.height/2.0f },
         .offset = { GetScreenWidth()/2.0f, GetScreenHeight()/2.0f },
         .rotation = 0.0f,
         .zoom = 1.0f
     };
 
     bool reachedAgua=false, reachedFogo=false, reachedTerra=false;
+
+    // Portas travam o "chegou" no primeiro ENTER; botões são lidos pela ocupação
+    TriggerWorld triggers;
+    TriggerWorld_Init(&triggers);
+    TriggerWorld_Add(&triggers, doorAgua,  1u << PHASE_WATER, TriggerLatchOnEnter, &reachedAgua);
+    TriggerWorld_Add(&triggers, doorFogo,  1u << PHASE_FIRE,  TriggerLatchOnEnter, &reachedFogo);
+    TriggerWorld_Add(&triggers, doorTerra, 1u << PHASE_EARTH, TriggerLatchOnEnter, &reachedTerra);
+    int buttonTrigger[MAX_BUTTONS];
+    for (int i=0;i<buttonCount;i++)
+        buttonTrigger[i] = TriggerWorld_Add(&triggers, buttons[i].rect, TRIGGER_ALL_BODIES, NULL, NULL);
     bool debug=false, completed=false;
     float elapsed=0.0f;
+    float lakeTime=0.0f;
     SetTargetFPS(60);
 
+    SimClock simClock;
+    SimClock_Start(&simClock);
+
+    // Estado dos ventiladores no último tick: um frame sem tick desenha o mesmo
+    bool fan1Active = false, fan2Active = false;
     while (!WindowShouldClose()) {
         Theme_Update();
+        RenderScale_Update();
+        FrameCapture_Update();
         float dt = GetFrameTime();
-        elapsed += dt;
+        lakeTime += dt;
+        Particles_Update(dt);
         if (IsKeyPressed(KEY_TAB)) debug = !debug;
 
-        if (IsKeyPressed(KEY_ESCAPE)) {
-            PauseResult pr = ShowPauseMenu();
-            if (pr == PAUSE_TO_MAP) { completed = false; break; }
-            if (pr == PAUSE_TO_MENU) { Game_SetReturnToMenu(true); completed = false; break; }
-        }
-
-        UpdatePlayer(&watergirl, (Rectangle){0,mapTexture.height,mapTexture.width,200}, KEY_A, KEY_D, KEY_W);
-        UpdatePlayer(&fireboy,   (Rectangle){0,mapTexture.height,mapTexture.width,200}, KEY_LEFT, KEY_RIGHT, KEY_UP);
-        UpdatePlayer(&earthboy,  (Rectangle){0,mapTexture.height,mapTexture.width,200}, KEY_J, KEY_L, KEY_I);
-
         Player* players[3] = { &earthboy, &fireboy, &watergirl };
-        PhaseResolvePlayersVsWorld(players, 3, colisoes, totalColisoes, PHASE_STEP_HEIGHT);
-
-        bool buttonStates[MAX_BUTTONS] = { false };
-        for (int i=0;i<buttonCount;i++) {
-            buttonStates[i] = ButtonUpdate(&buttons[i], &earthboy, &fireboy, &watergirl);
-        }
-
-        for (int i=0;i<platformCount;i++) {
-            Platform* plat = &platforms[i];
-            float targetDown = plat->area.y + plat->area.height - plat->rect.height;
-            float targetUp = plat->area.y;
-            bool active = false;
-            if (platformControlTokens[i][0]) {
-                active = PhaseAnyButtonPressedWithToken(buttonStates, buttonNamesLower, buttonCount, platformControlTokens[i]);
+        // Física em passo fixo: o número de ticks depende só do tempo real, não do FPS
+        int ticks = SimClock_Advance(&simClock, dt);
+        for (int tick = 0; tick < ticks; ++tick) {
+            SimClock_Tick(&simClock);
+            UpdatePlayer(&watergirl, (Rectangle){0,background.height,background.width,200}, KEY_A, KEY_D, KEY_W);
+            UpdatePlayer(&fireboy,   (Rectangle){0,background.height,background.width,200}, KEY_LEFT, KEY_RIGHT, KEY_UP);
+            UpdatePlayer(&earthboy,  (Rectangle){0,background.height,background.width,200}, KEY_J, KEY_L, KEY_I);
+
+            PhaseResolvePlayersVsWorld(players, 3, &grid, PHASE_STEP_HEIGHT);
+
+            bool respawnAll = false;
+            for (int p = 0; p < 3 && !respawnAll; ++p) {
+                Player* pl = players[p];
+                LakeType elem = (p == 0) ? LAKE_EARTH : (p == 1 ? LAKE_FIRE : LAKE_WATER);
+                LakeType hit;
+                if (LakeIndex_Query(&lakeIndex, pl->rect, elem, &hit) == LAKE_VERDICT_LETHAL) {
+                    Particles_BurstDeath(pl->rect, hit);
+                    respawnAll = true;
+                }
             }
-            float inactiveTarget = platformMoveDownActive[i] ? targetUp : targetDown;
-            float activeTarget = platformMoveDownActive[i] ? targetDown : targetUp;
-            float target = active ? activeTarget : inactiveTarget;
-            plat->rect.y = PhaseMoveTowards(plat->rect.y, target, plat->speed);
-            float minY = plat->area.y;
-            float maxY = plat->area.y + plat->area.height - plat->rect.height;
-            if (plat->rect.y < minY) plat->rect.y = minY;
-            if (plat->rect.y > maxY) plat->rect.y = maxY;
-            if (platformCollisionIndex[i] >= 0 && platformCollisionIndex[i] < totalColisoes) {
-                colisoes[platformCollisionIndex[i]].rect = plat->rect;
+            if (respawnAll) {
+                earthboy.rect.x = spawnTerra.x; earthboy.rect.y = spawnTerra.y;
+                fireboy.rect.x  = spawnFogo.x;  fireboy.rect.y  = spawnFogo.y;
+                watergirl.rect.x= spawnAgua.x;  watergirl.rect.y= spawnAgua.y;
+                earthboy.velocity = fireboy.velocity = watergirl.velocity = (Vector2){0,0};
+                earthboy.isJumping = fireboy.isJumping = watergirl.isJumping = false;
+                continue;
             }
-        }
-
-        bool fan1Active = PhaseAnyButtonPressedWithToken(buttonStates, buttonNamesLower, buttonCount, "ventilador1");
-        bool fan2Active = PhaseAnyButtonPressedWithToken(buttonStates, buttonNamesLower, buttonCount, "botao3ventilador2_marrom");
 
-        if (fanOnCount > 0) {
-            fanAnimTimer += dt;
-            if (fanAnimTimer >= FAN_FRAME_TIME) {
-                fanAnimTimer -= FAN_FRAME_TIME;
-                fanAnimFrame = (fanAnimFrame + 1) % fanOnCount;
+            // Uma atualização por tick, com os jogadores já no lugar: portas e botões
+            // veem ENTER/EXIT no mesmo ponto do tick que nas outras fases
+            TriggerWorld_Update(&triggers, players, 3);
+            uint32_t pressedMask = 0;
+            for (int i=0;i<buttonCount;i++) {
+                buttons[i].pressed = TriggerWorld_Occupancy(&triggers, buttonTrigger[i]) != 0;
+                if (buttons[i].pressed) pressedMask |= 1u << i;
             }
-        }
-        if (fan2Active && fanOnCount > 0) {
-            fan2AnimTimer += dt;
-            if (fan2AnimTimer >= FAN_FRAME_TIME) {
-                fan2AnimTimer -= FAN_FRAME_TIME;
-                fan2AnimFrame = (fan2AnimFrame + 1) % fanOnCount;
+            SignalGraph_SetInputs(&signals, pressedMask);
+
+            for (int i=0;i<platformCount;i++) {
+                Platform* plat = &platforms[i];
+                float targetDown = plat->area.y + plat->area.height - plat->rect.height;
+                float targetUp = plat->area.y;
+                bool active = SignalGraph_Output(&signals, platformSignal[i]);
+                float inactiveTarget = platformMoveDownActive[i] ? targetUp : targetDown;
+                float activeTarget = platformMoveDownActive[i] ? targetDown : targetUp;
+                float target = active ? activeTarget : inactiveTarget;
+                plat->rect.y = PhaseMoveTowards(plat->rect.y, target, plat->speed);
+                float minY = plat->area.y;
+                float maxY = plat->area.y + plat->area.height - plat->rect.height;
+                if (plat->rect.y < minY) plat->rect.y = minY;
+                if (plat->rect.y > maxY) plat->rect.y = maxY;
+                KinematicWorld_Move(&kinematics, platformBody[i], plat->rect, players, 3);
             }
-        } else {
-            fan2AnimTimer = 0.0f;
-            fan2AnimFrame = 0;
-        }
 
-        for (int i=0;i<fans1Count;i++) {
-            if (fan1Active) {
-                FanApply(&fans1[i], &earthboy);
-                FanApply(&fans1[i], &fireboy);
-                FanApply(&fans1[i], &watergirl);
-            }
-        }
-        for (int i=0;i<fans2Count;i++) {
-            if (fan2Active) {
-                FanApply(&fans2[i], &earthboy);
-                FanApply(&fans2[i], &fireboy);
-                FanApply(&fans2[i], &watergirl);
-            }
-        }
+            fan1Active = SignalGraph_Output(&signals, fan1Signal);
+            fan2Active = SignalGraph_Output(&signals, fan2Signal);
 
-        bool respawnAll = false;
-        for (int p = 0; p < 3 && !respawnAll; ++p) {
-            Player* pl = players[p];
-            LakeType elem = (p == 0) ? LAKE_EARTH : (p == 1 ? LAKE_FIRE : LAKE_WATER);
-            for (int i = 0; i < lakeSegCount; ++i) {
-                Lake temp; temp.rect = lakeSegs[i].rect; temp.type = lakeSegs[i].type; temp.color = WHITE;
-                if (LakeHandlePlayer(&temp, pl, elem)) {
-                    respawnAll = true;
-                    break;
+            if (fanOnCount > 0) {
+                fanAnimTimer += SIM_TICK_DT;
+                if (fanAnimTimer >= FAN_FRAME_TIME) {
+                    fanAnimTimer -= FAN_FRAME_TIME;
+                    fanAnimFrame = (fanAnimFrame + 1) % fanOnCount;
                 }
             }
-        }
-        if (respawnAll) {
-            earthboy.rect.x = spawnTerra.x; earthboy.rect.y = spawnTerra.y;
-            fireboy.rect.x  = spawnFogo.x;  fireboy.rect.y  = spawnFogo.y;
-            watergirl.rect.x= spawnAgua.x;  watergirl.rect.y= spawnAgua.y;
-            earthboy.velocity = fireboy.velocity = watergirl.velocity = (Vector2){0,0};
-            earthboy.isJumping = fireboy.isJumping = watergirl.isJumping = false;
-            continue;
-        }
+            if (fan2Active && fanOnCount > 0) {
+                fan2AnimTimer += SIM_TICK_DT;
+                if (fan2AnimTimer >= FAN_FRAME_TIME) {
+                    fan2AnimTimer -= FAN_FRAME_TIME;
+                    fan2AnimFrame = (fan2AnimFrame + 1) % fanOnCount;
+                }
+            } else {
+                fan2AnimTimer = 0.0f;
+                fan2AnimFrame = 0;
+            }
+
+            for (int i=0;i<fans1Count;i++) Particles_SetEmitterActive(fan1Emitters[i], fan1Active);
+            for (int i=0;i<fans2Count;i++) Particles_SetEmitterActive(fan2Emitters[i], fan2Active);
 
-        reachedAgua = reachedAgua || PhaseCheckDoor(&doorAgua, &watergirl);
-        reachedFogo = reachedFogo || PhaseCheckDoor(&doorFogo, &fireboy);
-        reachedTerra= reachedTerra|| PhaseCheckDoor(&doorTerra, &earthboy);
-        if (reachedAgua && reachedFogo && reachedTerra) { completed = true; break; }
+            ForceFieldWorld_SyncSignals(&forceFields, &signals);
+            ForceFieldWorld_ApplyPlayers(&forceFields, players, 3);
+
+            if (reachedAgua && reachedFogo && reachedTerra) { completed = true; break; }
+        }
+        elapsed = SimClock_Seconds(&simClock);
+        if (completed) break;
 
         BeginDrawing();
         ClearBackground(BLACK);
-        BeginMode2D(camera);
+        RenderScale_BeginWorld();
+        BeginMode2D(RenderScale_WorldCamera(camera));
 
-        DrawTexture(mapTexture, 0, 0, WHITE);
+        PhaseBackgroundDraw(&background, camera);
 
         Player* drawPlayers[3] = { &earthboy, &fireboy, &watergirl };
         LakeType playerTypes[3] = { LAKE_EARTH, LAKE_FIRE, LAKE_WATER };
         bool playerBehindLake[3] = { false };
         for (int i = 0; i < 3; ++i) {
-            playerBehindLake[i] = PhasePlayerInsideOwnLake(drawPlayers[i], playerTypes[i], lakeSegs, lakeSegCount);
+            playerBehindLake[i] = LakeIndex_Query(&lakeIndex, drawPlayers[i]->rect, playerTypes[i], NULL) == LAKE_VERDICT_OWN;
         }
 
-        LakeAnimFrames* sets[4] = { &animAgua, &animFogo, &animTerra, &animAcido };
-        PhaseUpdateLakeAnimations(sets, 4, dt, 0.12f);
-
         for (int pass = 0; pass < 2; ++pass) {
-            if (pass == 1) {
-                for (int i = 0; i < lakeSegCount; ++i) {
-                    const LakeSegment* seg = &lakeSegs[i];
-                    const LakeAnimFrames* anim = NULL;
-                    switch (seg->type) {
-                        case LAKE_WATER: anim = &animAgua; break;
-                        case LAKE_FIRE: anim = &animFogo; break;
-                        case LAKE_EARTH: anim = &animTerra; break;
-                        case LAKE_POISON: anim = &animAcido; break;
-                    }
-                    const Texture2D* frameTex = PhasePickLakeFrame(anim, seg->part);
-                    if (frameTex && frameTex->id != 0 && seg->part == PART_MIDDLE) {
-                        Texture2D frame = *frameTex;
-                        float tile = seg->rect.height;
-                        int tiles = (int)floorf(seg->rect.width / tile);
-                        float x = seg->rect.x;
-                        for (int t=0;t<tiles;++t) {
-                            Rectangle dst = { x, seg->rect.y, tile, seg->rect.height };
-                            DrawTexturePro(frame, (Rectangle){0,0,(float)frame.width,(float)frame.height}, dst, (Vector2){0,0}, 0.0f, WHITE);
-                            x += tile;
-                        }
-                        float rest = seg->rect.width - tiles*tile;
-                        if (rest > 0.1f) {
-                            Rectangle dst = { x, seg->rect.y, rest, seg->rect.height };
-                            DrawTexturePro(frame, (Rectangle){0,0,(float)frame.width,(float)frame.height}, dst, (Vector2){0,0}, 0.0f, WHITE);
-                        }
-                    } else if (frameTex && frameTex->id != 0) {
-                        Texture2D frame = *frameTex;
-                        DrawTexturePro(frame, (Rectangle){0,0,(float)frame.width,(float)frame.height}, seg->rect, (Vector2){0,0}, 0.0f, WHITE);
-                    } else {
-                        Lake fallback; LakeInit(&fallback, seg->rect.x, seg->rect.y, seg->rect.width, seg->rect.height, seg->type);
-                        LakeDraw(&fallback);
-                    }
-                }
-            }
+            if (pass == 1) LakeRendererDraw(&lakeRenderer, lakeTime);
             for (int i = 0; i < 3; ++i) {
                 bool drawBehind = playerBehindLake[i];
                 if ((pass == 0 && drawBehind) || (pass == 1 && !drawBehind)) {
@@ -465,6 +468,8 @@ bool Fase2(void) {
         DrawRectangleLinesEx(doorTerra,2, cEarth);
 
 
+        Particles_Draw();
+
         if (debug) {
             for (int i=0;i<totalColisoes;i++) DrawRectangleLinesEx(colisoes[i].rect,1,Fade(GREEN,0.5f));
             for (int i=0;i<lakeSegCount;i++) DrawRectangleLinesEx(lakeSegs[i].rect,1,Fade(BLUE,0.4f));
@@ -472,28 +477,37 @@ bool Fase2(void) {
         }
 
         EndMode2D();
+        RenderScale_EndWorld();
+
+        TextCache_DrawClock(elapsed, true, 30, 30, 32, WHITE);
+        TextCache_Draw("Use os botoes para controlar ventiladores e barras", 30, 70, 20, RAYWHITE);
 
-        char timer[32];
-        int min = (int)(elapsed / 60.0f);
-        float sec = elapsed - min * 60.0f;
-        sprintf(timer, "%02d:%05.2f", min, sec);
-        DrawText(timer, 30, 30, 32, WHITE);
-        DrawText("Use os botoes para controlar ventiladores e barras", 30, 70, 20, RAYWHITE);
+        Pause_FrameEnd();
+        FrameCapture_Frame();
 
         EndDrawing();
+
+        // ESC congela o frame que acabou de ser desenhado e só então abre o pause
+        if (Pause_Pending()) {
+            PauseResult pr = ShowPauseMenu();
+            if (pr == PAUSE_TO_MAP) { completed = false; break; }
+            if (pr == PAUSE_TO_MENU) { Game_SetReturnToMenu(true); completed = false; break; }
+        }
     }
 
-    UnloadTexture(mapTexture);
+    PhaseBackgroundUnload(&background);
+    CollisionGrid_Free(&grid);
     if (barra1Tex.id) UnloadTexture(barra1Tex);
     if (barra2Tex.id) UnloadTexture(barra2Tex);
     if (barraFallbackTex.id) UnloadTexture(barraFallbackTex);
     PhaseUnloadButtonSprites(&buttonSprites);
     if (fanOffTex.id) UnloadTexture(fanOffTex);
     for (int i=0;i<fanOnCount;i++) if (fanOnFrames[i].id) UnloadTexture(fanOnFrames[i]);
-    PhaseUnloadLakeSet(&animAgua);
-    PhaseUnloadLakeSet(&animFogo);
-    PhaseUnloadLakeSet(&animTerra);
-    PhaseUnloadLakeSet(&animAcido);
+    LakeRendererUnload(&lakeRenderer);
+    LakeIndex_Free(&lakeIndex);
+    TriggerWorld_Free(&triggers);
+    ForceFieldWorld_Free(&forceFields);
+    Particles_Reset();
     UnloadPlayer(&earthboy);
     UnloadPlayer(&fireboy);
     UnloadPlayer(&watergirl);
@@ -2,54 +2,35 @@
 #include "../../player/player.h"
 #include "../../objects/lake.h"
 #include "../../objects/button.h"
+#include "../../objects/box.h"
 #include "../../game/game.h"
+#include "../../game/sim_clock.h"
+#include "../../game/sim_input.h"
+#include "../../game/sim_world.h"
 #include "../../ranking/ranking.h"
 #include "../../objects/fan.h"
 #include "../../interface/pause.h"
 #include "../../audio/theme.h"
+#include "../../render/render_scale.h"
+#include "../../render/particles.h"
+#include "../../render/frame_capture.h"
+#include "../../render/render_stats.h"
+#include "../../interface/text_cache.h"
 #include "phase_common.h"
+#include "lake_renderer.h"
+#include "tilemap_renderer.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <ctype.h>
 
-#define MAX_COLISOES 1024
-#define MAX_BUTTONS 16
-#define MAX_COOP_BOXES 4
 #define MAX_FAN_FRAMES 8
 #define FAN_FRAME_TIME 0.12f
 
 static const char* const FASE1_TMX_PATH = "assets/maps/fase4/fase4.tmx";
 static const char* const FASE1_MAP_TEXTURE = "assets/maps/fase4/fase4.png";
 
-#define MAX_LAKE_SEGS 256
-
-typedef struct PhaseButton {
-    Button button;
-    char name[BUTTON_NAME_LEN];
-    char nameLower[BUTTON_NAME_LEN];
-    bool pressed;
-} PhaseButton;
-
-static bool AnyButtonPressedWithToken(const PhaseButton* buttons, int count, const char* tokenLower) {
-    if (!tokenLower || !tokenLower[0]) return false;
-    for (int i = 0; i < count; ++i) {
-        if (buttons[i].pressed && strstr(buttons[i].nameLower, tokenLower)) return true;
-    }
-    return false;
-}
-
-static bool PlayerAtDoor(const Player* p, Rectangle door) {
-    if (door.width <= 0 || door.height <= 0) return false;
-    Rectangle expanded = door;
-    expanded.x -= 12.0f;
-    expanded.width += 24.0f;
-    expanded.y -= 6.0f;
-    expanded.height += 12.0f;
-    return CheckCollisionRecs(p->rect, expanded);
-}
-
 static void DrawPlatformWithTexture(const Platform* plat, Texture2D tex, Color fallback) {
     if (plat->rect.width <= 0 || plat->rect.height <= 0) return;
     if (tex.id == 0) {
@@ -108,78 +89,6 @@ static void DrawFanColumn(Rectangle column, Texture2D frame) {
     }
 }
 
-typedef struct {
-    Rectangle rect;
-    float velX;
-    float velY;
-} CoOpBox;
-
-static bool PlayerPushingBox(const Player* pl, Rectangle box, bool pushRight, int key, float tol) {
-    if (!IsKeyDown(key)) return false;
-    Rectangle expanded = box;
-    expanded.x -= 3.0f; expanded.width += 6.0f;
-    expanded.y -= 4.0f; expanded.height += 8.0f;
-    if (!CheckCollisionRecs(pl->rect, expanded)) return false;
-    float pLeft = pl->rect.x;
-    float pRight = pl->rect.x + pl->rect.width;
-    if (pushRight) {
-        if (pLeft >= box.x) return false;
-        return fabsf(pRight - box.x) <= tol;
-    } else {
-        if (pRight <= box.x + box.width) return false;
-        return fabsf(pLeft - (box.x + box.width)) <= tol;
-    }
-}
-
-static void ResolvePlayerVsCoOpBox(Player* pl, const CoOpBox* box, float deltaX) {
-    if (!CheckCollisionRecs(pl->rect, box->rect)) return;
-    float dx = (pl->rect.x + pl->rect.width*0.5f) - (box->rect.x + box->rect.width*0.5f);
-    float dy = (pl->rect.y + pl->rect.height*0.5f) - (box->rect.y + box->rect.height*0.5f);
-    float overlapX = (pl->rect.width*0.5f + box->rect.width*0.5f) - fabsf(dx);
-    float overlapY = (pl->rect.height*0.5f + box->rect.height*0.5f) - fabsf(dy);
-    if (overlapX <= 0 || overlapY <= 0) return;
-    if (overlapX < overlapY) {
-        if (dx > 0) pl->rect.x += overlapX;
-        else        pl->rect.x -= overlapX;
-        pl->velocity.x = 0;
-    } else {
-        if (dy > 0 && pl->velocity.y < 0) {
-            pl->rect.y += overlapY;
-            pl->velocity.y = 0;
-        } else if (dy < 0 && pl->velocity.y >= 0) {
-            pl->rect.y -= overlapY;
-            pl->velocity.y = 0;
-            pl->isJumping = false;
-            pl->rect.x += deltaX;
-        }
-    }
-}
-
-static void ResolveCoOpBoxVsWorld(CoOpBox* box, const Colisao* col, int colCount) {
-    for (int i = 0; i < colCount; ++i) {
-        Rectangle bloco = col[i].rect;
-        if (!CheckCollisionRecs(box->rect, bloco)) continue;
-        float dx = (box->rect.x + box->rect.width*0.5f) - (bloco.x + bloco.width*0.5f);
-        float dy = (box->rect.y + box->rect.height*0.5f) - (bloco.y + bloco.height*0.5f);
-        float overlapX = (box->rect.width*0.5f + bloco.width*0.5f) - fabsf(dx);
-        float overlapY = (box->rect.height*0.5f + bloco.height*0.5f) - fabsf(dy);
-        if (overlapX <= 0 || overlapY <= 0) continue;
-        if (overlapX < overlapY) {
-            if (dx > 0) box->rect.x += overlapX;
-            else        box->rect.x -= overlapX;
-            box->velX = 0;
-        } else {
-            if (dy > 0) box->rect.y += overlapY;
-            else        box->rect.y -= overlapY;
-            box->velY = 0;
-        }
-    }
-}
-
-
-
-
-
 static void DetermineButtonColors(const char* nameLower, Color* up, Color* down) {
     if (strstr(nameLower, "azul")) {
         *up = (Color){70, 120, 240, 220};
@@ -206,142 +115,50 @@ static void DetermineButtonColors(const char* nameLower, Color* up, Color* down)
 }
 
 
-
-
-
-static int ParseColisoesDaCamada(const char* tmxPath, Colisao* out, int outCap) {
-    Rectangle rects[MAX_COLISOES];
-    int n = ParseRectsFromGroup(tmxPath, "Colisao", rects, MAX_COLISOES);
-    if (n > outCap) n = outCap;
-    for (int i = 0; i < n; ++i) out[i].rect = rects[i];
-    return n;
-}
-
+// Front-end raylib da fase 4: a física (caixas, barra, elevadores, ventilador,
+// botões e portas) é um SimWorld; aqui ficam texturas, partículas e desenho
 bool Fase4(void) {
-    // --- Carrega colisões somente da camada de objetos "Colisao" ---
-    Colisao colisoes[MAX_COLISOES];
-    int totalColisoes = ParseColisoesDaCamada(FASE1_TMX_PATH, colisoes, MAX_COLISOES);
-    if (totalColisoes <= 0) {
-        printf("Nao foi possivel carregar colisoes da camada 'Colisao' em %s\n", FASE1_TMX_PATH);
-    }
-
-    // --- Carrega segmentos de lagos conforme camadas do Tiled ---
-    LakeSegment lakeSegs[MAX_LAKE_SEGS]; int lakeCount = 0;
-    Rectangle tmpRects[128]; int n;
-    // Agua
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Agua_Esquerdo", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_WATER, PART_LEFT };
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Agua_Meio", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_WATER, PART_MIDDLE };
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Agua_Direito", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_WATER, PART_RIGHT };
-    // Fogo
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Fogo_Esquerdo", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_FIRE, PART_LEFT };
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Fogo_Meio", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_FIRE, PART_MIDDLE };
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Fogo_Direito", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_FIRE, PART_RIGHT };
-    // Terra (marrom)
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Marrom_Esquerdo", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_EARTH, PART_LEFT };
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Marrom_Meio", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_EARTH, PART_MIDDLE };
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Marrom_Direito", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_EARTH, PART_RIGHT };
-    // Veneno (verde)
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Verde_Esquerda", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_POISON, PART_LEFT };
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Verde_Meio", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_POISON, PART_MIDDLE };
-    n = ParseRectsFromGroup(FASE1_TMX_PATH, "Lago_Verde_Direita", tmpRects, 128);
-    for (int i = 0; i < n && lakeCount < MAX_LAKE_SEGS; ++i) lakeSegs[lakeCount++] = (LakeSegment){ tmpRects[i], LAKE_POISON, PART_RIGHT };
-
-    // Carrega animações para cada tipo com assets existentes
-    LakeAnimFrames animAgua = {0}, animFogo = {0}, animTerra = {0}, animAcido = {0};
-    LoadLakeSet_Agua(&animAgua);
-    LoadLakeSet_Fogo(&animFogo);
-    LoadLakeSet_Terra(&animTerra);
-    LoadLakeSet_Acido(&animAcido);
+    SimWorld* w = (SimWorld*)calloc(1, sizeof(SimWorld));
+    if (!w) return false;
 
     // --- Carrega textura do mapa ---
-    Texture2D mapTexture = LoadTexture(FASE1_MAP_TEXTURE);
-    if (mapTexture.id == 0) {
+    PhaseBackground background;
+    if (!PhaseBackgroundLoad(&background, FASE1_TMX_PATH, FASE1_MAP_TEXTURE)) {
         printf("Erro ao carregar %s\n", FASE1_MAP_TEXTURE);
+        free(w);
+        return false;
+    }
+    if (!SimWorld_LoadCoopMap(w, FASE1_TMX_PATH, background.width, background.height)) {
+        printf("Nao foi possivel carregar o mapa %s\n", FASE1_TMX_PATH);
+        PhaseBackgroundUnload(&background);
+        free(w);
         return false;
     }
 
-    Rectangle doorTerra = { mapTexture.width - 210.0f, mapTexture.height - 180.0f, 40.0f, 120.0f };
-    Rectangle doorFogo  = { mapTexture.width - 150.0f, mapTexture.height - 180.0f, 40.0f, 120.0f };
-    Rectangle doorAgua  = { mapTexture.width -  90.0f, mapTexture.height - 180.0f, 40.0f, 120.0f };
-    Rectangle doorBuf[2];
-    if (ParseRectsFromGroup(FASE1_TMX_PATH, "Porta_Terra", doorBuf, 1) > 0) doorTerra = doorBuf[0];
-    if (ParseRectsFromGroup(FASE1_TMX_PATH, "Porta_Fogo",  doorBuf, 1) > 0) doorFogo  = doorBuf[0];
-    if (ParseRectsFromGroup(FASE1_TMX_PATH, "Porta_Agua",  doorBuf, 1) > 0) doorAgua  = doorBuf[0];
-
-    // --- Botões definidos nas camadas de objetos ---
-    PhaseButton buttons[MAX_BUTTONS] = {0};
-    int buttonCount = 0;
+    // Carrega animações para cada tipo com assets existentes
+    LakeRenderer lakeRenderer;
+    LakeRendererLoad(&lakeRenderer, w->lakeSegs, w->lakeSegCount, 0.12f);
+    Particles_Reset();
+    for (int i = 0; i < w->lakeSegCount; ++i) Particles_AddLakeEmitter(w->lakeSegs[i].rect, w->lakeSegs[i].type);
+
+    // --- Botões: aparência pelo nome da camada, estado vem do núcleo ---
+    Button buttons[SIM_MAX_BUTTONS] = {0};
     ButtonSpriteSet buttonSprites = {0};
     PhaseLoadButtonSprites(&buttonSprites);
-
-    char groupNames[MAX_BUTTONS][BUTTON_NAME_LEN] = {{0}};
-    int groupCount = PhaseCollectButtonGroupNames(FASE1_TMX_PATH, groupNames, MAX_BUTTONS);
-    Rectangle btnBuffer[8];
-    for (int g = 0; g < groupCount && buttonCount < MAX_BUTTONS; ++g) {
-        int rectsFound = ParseRectsFromGroup(FASE1_TMX_PATH, groupNames[g], btnBuffer, (int)(sizeof(btnBuffer)/sizeof(btnBuffer[0])));
-        if (rectsFound <= 0) continue;
-        char lowerName[BUTTON_NAME_LEN];
-        PhaseToLowerCopy(groupNames[g], lowerName, sizeof(lowerName));
+    for (int i = 0; i < w->buttonCount; ++i) {
+        const SimButton* b = &w->buttons[i];
         Color colorUp, colorDown;
-        DetermineButtonColors(lowerName, &colorUp, &colorDown);
-        const Texture2D* sprite = PhasePickButtonSprite(&buttonSprites, lowerName);
-        for (int r = 0; r < rectsFound && buttonCount < MAX_BUTTONS; ++r) {
-            Rectangle rect = btnBuffer[r];
-            ButtonInit(&buttons[buttonCount].button, rect.x, rect.y, rect.width, rect.height, colorUp, colorDown);
-            if (sprite) ButtonSetSprites(&buttons[buttonCount].button, sprite, NULL);
-            strncpy(buttons[buttonCount].name, groupNames[g], BUTTON_NAME_LEN - 1);
-            buttons[buttonCount].name[BUTTON_NAME_LEN - 1] = '\0';
-            PhaseToLowerCopy(groupNames[g], buttons[buttonCount].nameLower, BUTTON_NAME_LEN);
-            buttons[buttonCount].pressed = false;
-            buttonCount++;
-        }
-    }
-
-    Platform barra1 = {0};
-    Platform elevador1 = {0};
-    Platform elevador2 = {0};
-    int barra1ColIndex = -1;
-    Rectangle rectBuf[2];
-    Rectangle areaBuf[2];
-    int rectCount = ParseRectsFromGroup(FASE1_TMX_PATH, "Barra1", rectBuf, 1);
-    if (rectCount > 0) {
-        Rectangle area = rectBuf[0];
-        if (ParseRectsFromGroup(FASE1_TMX_PATH, "AreaMovimentoBarra1", areaBuf, 1) > 0) area = areaBuf[0];
-        PhasePlatformInit(&barra1, rectBuf[0], area, 2.0f);
-        if (totalColisoes < MAX_COLISOES) {
-            barra1ColIndex = totalColisoes;
-            colisoes[totalColisoes++].rect = barra1.rect;
-        }
-    }
-    rectCount = ParseRectsFromGroup(FASE1_TMX_PATH, "Elevaodor1_Colisao", rectBuf, 1);
-    if (rectCount > 0) {
-        Rectangle area = rectBuf[0];
-        if (ParseRectsFromGroup(FASE1_TMX_PATH, "Elavador1_area", areaBuf, 1) > 0) area = areaBuf[0];
-        PhasePlatformInit(&elevador1, rectBuf[0], area, 1.6f);
-    }
-    rectCount = ParseRectsFromGroup(FASE1_TMX_PATH, "Elevaodor2_Colisao", rectBuf, 1);
-    if (rectCount > 0) {
-        Rectangle area = rectBuf[0];
-        if (ParseRectsFromGroup(FASE1_TMX_PATH, "Elavador2_area", areaBuf, 1) > 0) area = areaBuf[0];
-        PhasePlatformInit(&elevador2, rectBuf[0], area, 1.8f);
+        DetermineButtonColors(b->nameLower, &colorUp, &colorDown);
+        ButtonInit(&buttons[i], b->rect.x, b->rect.y, b->rect.width, b->rect.height, colorUp, colorDown);
+        const Texture2D* sprite = PhasePickButtonSprite(&buttonSprites, b->nameLower);
+        if (sprite) ButtonSetSprites(&buttons[i], sprite, NULL);
     }
 
     Texture2D barraAzulTex = LoadTexture("assets/map/barras/BarraAzulFase1.png");
     if (barraAzulTex.id == 0) barraAzulTex = LoadTexture("assets/map/barras/azul.png");
     Texture2D barraBrancaTex = LoadTexture("assets/map/barras/branca.png");
     Fan vent1 = {0}; bool haveFan = false;
-    Rectangle fanArea = (Rectangle){0};
+    Rectangle fanArea = w->forceFields.count > 0 ? w->forceFields.volumes[0].rect : (Rectangle){0};
     Texture2D fanFrames[MAX_FAN_FRAMES] = {0};
     int fanFrameCount = 0;
     float fanAnimTimer = 0.0f;
@@ -353,9 +170,9 @@ bool Fase4(void) {
             FanInit(&vent1, ventRects[0].x, ventRects[0].y, ventRects[0].width, ventRects[0].height, 0.4f);
             haveFan = true;
         }
-        Rectangle areaRect[2];
-        if (ParseRectsFromGroup(FASE1_TMX_PATH, "Area_Ventilador1", areaRect, 2) > 0) fanArea = areaRect[0];
-        else if (haveFan) fanArea = vent1.rect;
+        // Este ventilador empurra para baixo: correntes de ar descendo pela área
+        if (fanArea.width > 0 && fanArea.height > 0)
+            Particles_AddEmitter(PARTICLE_FAN_DOWN, fanArea, fanArea.width / 27.0f * 10.0f);
         const char* fanPaths[] = {
             "assets/map/vento/ligado1.png",
             "assets/map/vento/ligado2.png",
@@ -367,185 +184,84 @@ bool Fase4(void) {
             if (tex.id != 0) fanFrames[fanFrameCount++] = tex;
         }
     }
-    CoOpBox coopBoxes[MAX_COOP_BOXES]; int coopBoxCount = 0;
-    {
-        Rectangle boxRects[MAX_COOP_BOXES];
-        int boxCount = ParseRectsFromGroup(FASE1_TMX_PATH, "Caixa", boxRects, MAX_COOP_BOXES);
-        for (int i = 0; i < boxCount && coopBoxCount < MAX_COOP_BOXES; ++i) {
-            coopBoxes[coopBoxCount].rect = boxRects[i];
-            coopBoxes[coopBoxCount].velX = 0.0f;
-            coopBoxes[coopBoxCount].velY = 0.0f;
-            coopBoxCount++;
-        }
-    }
     Texture2D coopBoxTex = LoadTexture("assets/map/caixa/caixa2.png");
     if (coopBoxTex.id == 0) coopBoxTex = LoadTexture("assets/map/caixa/caixa.png");
 
-    // --- Inicializa jogadores menores ---
-    Player earthboy, fireboy, watergirl;
-    InitEarthboy(&earthboy);
-    InitFireboy(&fireboy);
-    InitWatergirl(&watergirl);
-
-    earthboy.rect = (Rectangle){300, 700, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT};
-    fireboy.rect  = (Rectangle){400, 700, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT};
-    watergirl.rect= (Rectangle){500, 700, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT};
-    Vector2 spawnEarth = (Vector2){ earthboy.rect.x, earthboy.rect.y };
-    Vector2 spawnFire  = (Vector2){ fireboy.rect.x,  fireboy.rect.y };
-    Vector2 spawnWater = (Vector2){ watergirl.rect.x, watergirl.rect.y };
+    // --- Sprites por cima do corpo que o núcleo criou; depois volta todo mundo ao spawn ---
+    Player* players[3] = { &w->players[PHASE_EARTH], &w->players[PHASE_FIRE], &w->players[PHASE_WATER] };
+    InitEarthboy(players[PHASE_EARTH]);
+    InitFireboy(players[PHASE_FIRE]);
+    InitWatergirl(players[PHASE_WATER]);
+    SimWorld_Respawn(w);
 
     // --- Câmera fixa ---
     Camera2D camera = {0};
-    camera.target = (Vector2){mapTexture.width / 2.0f, mapTexture.height / 2.0f};
+    camera.target = (Vector2){background.width / 2.0f, background.height / 2.0f};
     camera.offset = (Vector2){GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
     camera.zoom = 1.0f;
 
     bool completed = false;
     float elapsed = 0.0f;
+    float lakeTime = 0.0f;
     bool debug = false;
     SetTargetFPS(60);
 
+    SimClock frameClock;
+    SimClock_Start(&frameClock);
+
+    static const int keys[3][3] = {
+        { KEY_J, KEY_L, KEY_I },
+        { KEY_LEFT, KEY_RIGHT, KEY_UP },
+        { KEY_A, KEY_D, KEY_W }
+    };
+
     while (!WindowShouldClose()) {
         Theme_Update();
+        RenderScale_Update();
+        FrameCapture_Update();
         float dt = GetFrameTime();
-        elapsed += dt;
+        lakeTime += dt;
+        Particles_Update(dt);
         if (IsKeyPressed(KEY_TAB)) debug = !debug;
+        RenderStats_SetEnabled(debug);
+        if (debug && IsKeyPressed(KEY_F11)) RenderStats_ToggleCsv("render_stats.csv");
 
-        if (IsKeyPressed(KEY_ESCAPE)) {
-            PauseResult pr = ShowPauseMenu();
-            if (pr == PAUSE_TO_MAP) { completed = false; break; }
-            if (pr == PAUSE_TO_MENU) { Game_SetReturnToMenu(true); completed = false; break; }
-        }
-
-        // --- Atualiza jogadores ---
-        UpdatePlayer(&earthboy, (Rectangle){0, mapTexture.height, mapTexture.width, 100}, KEY_J, KEY_L, KEY_I);
-        UpdatePlayer(&fireboy,  (Rectangle){0, mapTexture.height, mapTexture.width, 100}, KEY_LEFT, KEY_RIGHT, KEY_UP);
-        UpdatePlayer(&watergirl,(Rectangle){0, mapTexture.height, mapTexture.width, 100}, KEY_A, KEY_D, KEY_W);
-
-        Player* players[3] = { &earthboy, &fireboy, &watergirl };
-        PhaseResolvePlayersVsWorld(players, 3, colisoes, totalColisoes, PHASE_STEP_HEIGHT);
-
-        struct { Player* pl; int keyLeft; int keyRight; } controls[3] = {
-            { &earthboy, KEY_J, KEY_L },
-            { &fireboy, KEY_LEFT, KEY_RIGHT },
-            { &watergirl, KEY_A, KEY_D }
-        };
-
-        const float BOX_GRAVITY = 0.45f;
-        const float BOX_MAX_FALL = 10.0f;
-        for (int b = 0; b < coopBoxCount; ++b) {
-            CoOpBox* box = &coopBoxes[b];
-            int pushRight = 0, pushLeft = 0;
-            for (int i = 0; i < 3; ++i) {
-                Player* pl = controls[i].pl;
-                if (PlayerPushingBox(pl, box->rect, true, controls[i].keyRight, 6.0f)) pushRight++;
-                else if (PlayerPushingBox(pl, box->rect, false, controls[i].keyLeft, 6.0f)) pushLeft++;
-            }
-            if (pushRight >= 2 && pushRight >= pushLeft) box->velX += 1.1f;
-            else if (pushLeft >= 2 && pushLeft > pushRight) box->velX -= 1.1f;
-            box->velY += BOX_GRAVITY;
-            if (box->velY > BOX_MAX_FALL) box->velY = BOX_MAX_FALL;
-
-            float prevX = box->rect.x;
-            box->rect.x += box->velX;
-            ResolveCoOpBoxVsWorld(box, colisoes, totalColisoes);
-            float deltaX = box->rect.x - prevX;
-            for (int i = 0; i < 3; ++i) {
-                ResolvePlayerVsCoOpBox(players[i], box, deltaX);
-            }
-            float prevY = box->rect.y;
-            box->rect.y += box->velY;
-            ResolveCoOpBoxVsWorld(box, colisoes, totalColisoes);
-            float deltaY = box->rect.y - prevY;
-            (void)deltaY;
-            box->velX *= 0.88f;
-            if (fabsf(box->velX) < 0.02f) box->velX = 0.0f;
-        }
-
-        // --- Interação com lagos: matar/reiniciar se tocar lago errado ---
-        bool respawnAll = false;
-        for (int p = 0; p < 3 && !respawnAll; ++p) {
-            Player* pl = players[p];
-            LakeType elem = (p == 0) ? LAKE_EARTH : (p == 1 ? LAKE_FIRE : LAKE_WATER);
-            for (int i = 0; i < lakeCount; ++i) {
-                Lake l; l.rect = lakeSegs[i].rect; l.type = lakeSegs[i].type; l.color = (Color){0};
-                if (LakeHandlePlayer(&l, pl, elem)) {
-                    respawnAll = true;
-                    break;
-                }
-            }
-        }
-        if (respawnAll) {
-            earthboy.rect.x = spawnEarth.x; earthboy.rect.y = spawnEarth.y;
-            fireboy.rect.x  = spawnFire.x;  fireboy.rect.y  = spawnFire.y;
-            watergirl.rect.x= spawnWater.x; watergirl.rect.y= spawnWater.y;
-            earthboy.velocity = fireboy.velocity = watergirl.velocity = (Vector2){0,0};
-            earthboy.isJumping = fireboy.isJumping = watergirl.isJumping = false;
-            continue;
-        }
-
-        for (int i = 0; i < buttonCount; ++i) {
-            buttons[i].pressed = ButtonUpdate(&buttons[i].button, &earthboy, &fireboy, &watergirl);
-        }
-
-        bool barraButtonsActive = AnyButtonPressedWithToken(buttons, buttonCount, "barra1");
-        bool elevador1Active =
-            AnyButtonPressedWithToken(buttons, buttonCount, "elevaodor1") ||
-            AnyButtonPressedWithToken(buttons, buttonCount, "elavador1") ||
-            AnyButtonPressedWithToken(buttons, buttonCount, "elevador1");
-        bool elevador2Active =
-            AnyButtonPressedWithToken(buttons, buttonCount, "elevaodor2") ||
-            AnyButtonPressedWithToken(buttons, buttonCount, "elavador2") ||
-            AnyButtonPressedWithToken(buttons, buttonCount, "elevador2");
-
-        bool earthAtDoor = PlayerAtDoor(&earthboy, doorTerra);
-        bool fireAtDoor  = PlayerAtDoor(&fireboy,  doorFogo);
-        bool waterAtDoor = PlayerAtDoor(&watergirl, doorAgua);
-        bool allAtAgua = PlayerAtDoor(&earthboy, doorAgua) &&
-                         PlayerAtDoor(&fireboy, doorAgua)  &&
-                         PlayerAtDoor(&watergirl, doorAgua);
-        if (allAtAgua) { completed = true; break; }
-
-        if (fanArea.width > 0 && fanArea.height > 0) {
+        // Física em passo fixo: o número de ticks depende só do tempo real, não do FPS
+        int ticks = SimClock_Advance(&frameClock, dt);
+        for (int tick = 0; tick < ticks && !w->finished; ++tick) {
+            SimInput in;
             for (int p = 0; p < 3; ++p) {
-                Player* pl = players[p];
-                if (CheckCollisionRecs(pl->rect, fanArea)) {
-                    pl->velocity.y += 0.35f;
-                    if (pl->velocity.y > 10.0f) pl->velocity.y = 10.0f;
-                }
+                in.players[p].left = IsKeyDown(keys[p][0]);
+                in.players[p].right = IsKeyDown(keys[p][1]);
+                in.players[p].jumpPressed = SimInput_Pressed(keys[p][2]);
             }
-            if (fanFrameCount > 0) {
-                fanAnimTimer += dt;
+            SimWorld_Step(w, &in);
+            for (int d = 0; d < w->deathCount; ++d) Particles_BurstDeath(w->deaths[d].at, w->deaths[d].lake);
+
+            if (fanArea.width > 0 && fanArea.height > 0 && fanFrameCount > 0) {
+                fanAnimTimer += SIM_TICK_DT;
                 if (fanAnimTimer >= FAN_FRAME_TIME) {
                     fanAnimTimer -= FAN_FRAME_TIME;
                     fanAnimFrame = (fanAnimFrame + 1) % fanFrameCount;
                 }
             }
         }
-
-        float barraDelta = PhasePlatformMoveTowards(&barra1, barraButtonsActive ? PhasePlatformBottomTarget(&barra1) : barra1.startY);
-        float elev1Delta = PhasePlatformMoveTowards(&elevador1, elevador1Active ? PhasePlatformBottomTarget(&elevador1) : elevador1.startY);
-        float elev2Delta = PhasePlatformMoveTowards(&elevador2, elevador2Active ? PhasePlatformBottomTarget(&elevador2) : elevador2.startY);
-
-        if (barra1ColIndex >= 0 && barra1ColIndex < totalColisoes) {
-            colisoes[barra1ColIndex].rect = barra1.rect;
-        }
-
-        for (int p = 0; p < 3; ++p) {
-            Player* pl = players[p];
-            if (barra1.rect.width > 0 && barra1.rect.height > 0) PhaseHandlePlatformTop(pl, barra1.rect, barraDelta);
-            if (elevador1.rect.width > 0 && elevador1.rect.height > 0) PhaseHandlePlatformTop(pl, elevador1.rect, elev1Delta);
-            if (elevador2.rect.width > 0 && elevador2.rect.height > 0) PhaseHandlePlatformTop(pl, elevador2.rect, elev2Delta);
-        }
+        elapsed = SimClock_Seconds(&w->clock);
+        if (w->finished) { completed = true; break; }
+        for (int i = 0; i < w->buttonCount; ++i) buttons[i].pressed = w->buttons[i].pressed;
 
         // --- Desenho ---
         BeginDrawing();
+        RenderStats_BeginFrame();
         ClearBackground(BLACK);
-        BeginMode2D(camera);
-
+        RenderScale_BeginWorld();
+        BeginMode2D(RenderScale_WorldCamera(camera));
 
-        DrawTexture(mapTexture, 0, 0, WHITE);
+        RenderStats_Begin(RENDER_SECTION_MAP);
+        PhaseBackgroundDraw(&background, camera);
+        RenderStats_End();
 
+        RenderStats_Begin(RENDER_SECTION_PROPS);
         if (haveFan) {
             Rectangle fanDrawArea = (fanArea.width > 0 && fanArea.height > 0) ? fanArea : vent1.rect;
             if (fanFrameCount > 0) {
@@ -557,30 +273,30 @@ bool Fase4(void) {
             }
         }
 
-        DrawPlatformWithTexture(&barra1, barraAzulTex, BLUE);
-        DrawPlatformWithTexture(&elevador1, barraBrancaTex, LIGHTGRAY);
-        DrawPlatformWithTexture(&elevador2, barraBrancaTex, LIGHTGRAY);
-        for (int b = 0; b < coopBoxCount; ++b) {
-            if (coopBoxTex.id != 0) {
-                DrawTexturePro(coopBoxTex, (Rectangle){0,0,(float)coopBoxTex.width,(float)coopBoxTex.height}, coopBoxes[b].rect, (Vector2){0,0}, 0.0f, WHITE);
-            } else {
-                DrawRectangleRec(coopBoxes[b].rect, DARKBROWN);
-            }
+        for (int i = 0; i < w->platformCount; ++i) {
+            if (i == 0) DrawPlatformWithTexture(&w->platforms[i].plat, barraAzulTex, BLUE);
+            else DrawPlatformWithTexture(&w->platforms[i].plat, barraBrancaTex, LIGHTGRAY);
+        }
+        for (int b = 0; b < w->boxCount; ++b) {
+            BoxDraw(&w->boxes[b], coopBoxTex, DARKBROWN);
         }
 
-        for (int i = 0; i < buttonCount; ++i) {
-            ButtonDraw(&buttons[i].button);
+        RenderStats_End();
+
+        RenderStats_Begin(RENDER_SECTION_BUTTONS);
+        for (int i = 0; i < w->buttonCount; ++i) {
+            ButtonDraw(&buttons[i]);
         }
+        RenderStats_End();
 
         // Decide quem está dentro do lago correto (para desenhar por trás)
         bool insideOwn[3] = { false, false, false };
-        Player* playersArr[3] = { &earthboy, &fireboy, &watergirl };
         LakeType elemsArr[3]  = { LAKE_EARTH, LAKE_FIRE, LAKE_WATER };
         for (int ip = 0; ip < 3; ++ip) {
-            Player* pl = playersArr[ip];
+            Player* pl = players[ip];
             LakeType elem = elemsArr[ip];
-            for (int i = 0; i < lakeCount; ++i) {
-                const LakeSegment* seg = &lakeSegs[i];
+            for (int i = 0; i < w->lakeSegCount; ++i) {
+                const LakeSegment* seg = &w->lakeSegs[i];
                 if (seg->type != elem) continue;
                 if (!CheckCollisionRecs(pl->rect, seg->rect)) continue;
                 // Requer pequena profundidade vertical para considerar "dentro"
@@ -590,107 +306,83 @@ bool Fase4(void) {
             }
         }
 
-        // Avança frames (8 FPS)
-        float lakeDt = GetFrameTime();
-        LakeAnimFrames* sets[4] = { &animAgua, &animFogo, &animTerra, &animAcido };
-        PhaseUpdateLakeAnimations(sets, 4, lakeDt, 0.12f);
-
         // 1) Desenha jogadores que estao dentro do lago correto (por trás)
-        if (insideOwn[0]) DrawPlayer(earthboy);
-        if (insideOwn[1]) DrawPlayer(fireboy);
-        if (insideOwn[2]) DrawPlayer(watergirl);
-
-        // 2) Desenha lagos animados por cima
-        for (int i = 0; i < lakeCount; ++i) {
-            const LakeSegment* seg = &lakeSegs[i];
-            const LakeAnimFrames* anim = NULL;
-            if (seg->type == LAKE_WATER) anim = &animAgua;
-            else if (seg->type == LAKE_FIRE) anim = &animFogo;
-            else if (seg->type == LAKE_EARTH) anim = &animTerra;
-            else if (seg->type == LAKE_POISON) anim = &animAcido;
-
-            const Texture2D* frameTex = PhasePickLakeFrame(anim, seg->part);
-            if (frameTex && frameTex->id != 0) {
-                Texture2D frame = *frameTex;
-                if (seg->part == PART_MIDDLE) {
-                    // Tile horizontal com passo de 27px (tamanho do tile do mapa)
-                    float tile = seg->rect.height; // 27 no mapa
-                    int tiles = (int)floorf(seg->rect.width / tile);
-                    float x = seg->rect.x;
-                    for (int t = 0; t < tiles; ++t) {
-                        Rectangle dst = (Rectangle){ x, seg->rect.y, tile, seg->rect.height };
-                        DrawTexturePro(frame, (Rectangle){0,0,(float)frame.width,(float)frame.height}, dst, (Vector2){0,0}, 0.0f, WHITE);
-                        x += tile;
-                    }
-                    // resto (se houver)
-                    float rest = seg->rect.width - tiles*tile;
-                    if (rest > 0.1f) {
-                        Rectangle dst = (Rectangle){ x, seg->rect.y, rest, seg->rect.height };
-                        DrawTexturePro(frame, (Rectangle){0,0,(float)frame.width,(float)frame.height}, dst, (Vector2){0,0}, 0.0f, WHITE);
-                    }
-                } else {
-                    DrawTexturePro(frame, (Rectangle){0,0,(float)frame.width,(float)frame.height}, seg->rect, (Vector2){0,0}, 0.0f, WHITE);
-                }
-            } else {
-                // Fallback: desenha sólido com cor se não houver animação
-                Color c = (seg->type==LAKE_POISON)? (Color){60,180,60,230} : (Color){90,90,90,200};
-                DrawRectangleRec(seg->rect, c);
-            }
-        }
+        RenderStats_Begin(RENDER_SECTION_PLAYERS);
+        for (int ip = 0; ip < 3; ++ip) if (insideOwn[ip]) DrawPlayer(*players[ip]);
+        RenderStats_End();
+
+        // 2) Desenha lagos animados por cima (atlas + shader, um único lote)
+        RenderStats_Begin(RENDER_SECTION_LAKES);
+        LakeRendererDraw(&lakeRenderer, lakeTime);
+        RenderStats_End();
 
         // 3) Desenha os demais jogadores por cima dos lagos
-        if (!insideOwn[0]) DrawPlayer(earthboy);
-        if (!insideOwn[1]) DrawPlayer(fireboy);
-        if (!insideOwn[2]) DrawPlayer(watergirl);
+        RenderStats_Begin(RENDER_SECTION_PLAYERS);
+        for (int ip = 0; ip < 3; ++ip) if (!insideOwn[ip]) DrawPlayer(*players[ip]);
+        RenderStats_End();
 
-        bool finishedByDoors = earthAtDoor && fireAtDoor && waterAtDoor;
+        RenderStats_Begin(RENDER_SECTION_PARTICLES);
+        Particles_Draw();
+        RenderStats_End();
 
         // --- Debug ---
         if (debug) {
-            for (int i = 0; i < totalColisoes; i++)
-                DrawRectangleLinesEx(colisoes[i].rect, 1, Fade(GREEN, 0.5f));
-            if (barra1.area.width > 0 && barra1.area.height > 0) DrawRectangleLinesEx(barra1.area, 1, Fade(BLUE, 0.4f));
-            if (elevador1.area.width > 0 && elevador1.area.height > 0) DrawRectangleLinesEx(elevador1.area, 1, Fade(LIGHTGRAY, 0.4f));
-            if (elevador2.area.width > 0 && elevador2.area.height > 0) DrawRectangleLinesEx(elevador2.area, 1, Fade(LIGHTGRAY, 0.4f));
+            RenderStats_Begin(RENDER_SECTION_DEBUG);
+            for (int i = 0; i < w->totalColisoes; i++)
+                DrawRectangleLinesEx(w->colisoes[i].rect, 1, Fade(GREEN, 0.5f));
+            for (int i = 0; i < w->platformCount; ++i) {
+                Rectangle area = w->platforms[i].plat.area;
+                if (area.width > 0 && area.height > 0) DrawRectangleLinesEx(area, 1, Fade(i == 0 ? BLUE : LIGHTGRAY, 0.4f));
+            }
             if (fanArea.width > 0 && fanArea.height > 0) DrawRectangleLinesEx(fanArea, 1, Fade(SKYBLUE, 0.4f));
-            DrawRectangleLinesEx(doorTerra, 1, Fade(BROWN, 0.6f));
-            DrawRectangleLinesEx(doorFogo, 1, Fade(RED, 0.6f));
-            DrawRectangleLinesEx(doorAgua, 1, Fade(BLUE, 0.6f));
-
-            DrawText(TextFormat("Earthboy: (%.0f, %.0f)", earthboy.rect.x, earthboy.rect.y), 10, 10, 20, YELLOW);
-            DrawText(TextFormat("Fireboy:  (%.0f, %.0f)", fireboy.rect.x, fireboy.rect.y), 10, 35, 20, ORANGE);
-            DrawText(TextFormat("Watergirl:(%.0f, %.0f)", watergirl.rect.x, watergirl.rect.y), 10, 60, 20, SKYBLUE);
-            DrawText("TAB - Modo Debug", 10, 90, 20, GRAY);
+            DrawRectangleLinesEx(w->door[PHASE_EARTH], 1, Fade(BROWN, 0.6f));
+            DrawRectangleLinesEx(w->door[PHASE_FIRE], 1, Fade(RED, 0.6f));
+            DrawRectangleLinesEx(w->door[PHASE_WATER], 1, Fade(BLUE, 0.6f));
+
+            DrawText(TextFormat("Earthboy: (%.0f, %.0f)", players[PHASE_EARTH]->rect.x, players[PHASE_EARTH]->rect.y), 10, 10, 20, YELLOW);
+            DrawText(TextFormat("Fireboy:  (%.0f, %.0f)", players[PHASE_FIRE]->rect.x, players[PHASE_FIRE]->rect.y), 10, 35, 20, ORANGE);
+            DrawText(TextFormat("Watergirl:(%.0f, %.0f)", players[PHASE_WATER]->rect.x, players[PHASE_WATER]->rect.y), 10, 60, 20, SKYBLUE);
+            TextCache_Draw("TAB - Modo Debug", 10, 90, 20, GRAY);
             DrawFPS(10, 120);
+            RenderStats_DrawOverlay(10, 150);
+            RenderStats_End();
         }
 
         EndMode2D();
+        RenderScale_EndWorld();
 
-        char timerTxt[32];
-        int min = (int)(elapsed / 60.0f);
-        float sec = elapsed - min * 60.0f;
-        snprintf(timerTxt, sizeof(timerTxt), "%02d:%05.2f", min, sec);
-        DrawText(timerTxt, 30, 30, 32, WHITE);
+        RenderStats_Begin(RENDER_SECTION_HUD);
+        TextCache_DrawClock(elapsed, true, 30, 30, 32, WHITE);
+        RenderStats_End();
 
+        RenderStats_EndFrame();
+        Pause_FrameEnd();
+        FrameCapture_Frame();
         EndDrawing();
 
-        if (finishedByDoors) { completed = true; break; }
+        // ESC congela o frame que acabou de ser desenhado e só então abre o pause
+        if (Pause_Pending()) {
+            PauseResult pr = ShowPauseMenu();
+            if (pr == PAUSE_TO_MAP) { completed = false; break; }
+            if (pr == PAUSE_TO_MENU) { Game_SetReturnToMenu(true); completed = false; break; }
+        }
     }
 
     // --- Libera recursos ---
-    UnloadTexture(mapTexture);
-    PhaseUnloadLakeSet(&animAgua);
-    PhaseUnloadLakeSet(&animFogo);
-    PhaseUnloadLakeSet(&animTerra);
-    PhaseUnloadLakeSet(&animAcido);
-    UnloadPlayer(&earthboy);
-    UnloadPlayer(&fireboy);
-    UnloadPlayer(&watergirl);
+    PhaseBackgroundUnload(&background);
+    RenderStats_SetEnabled(false);
+    LakeRendererUnload(&lakeRenderer);
+    Particles_Reset();
+    UnloadPlayer(players[PHASE_EARTH]);
+    UnloadPlayer(players[PHASE_FIRE]);
+    UnloadPlayer(players[PHASE_WATER]);
     if (barraAzulTex.id != 0) UnloadTexture(barraAzulTex);
     if (barraBrancaTex.id != 0) UnloadTexture(barraBrancaTex);
     if (coopBoxTex.id != 0) UnloadTexture(coopBoxTex);
     for (int i = 0; i < fanFrameCount; ++i) if (fanFrames[i].id != 0) UnloadTexture(fanFrames[i]);
     PhaseUnloadButtonSprites(&buttonSprites);
     if (completed) Ranking_Add(4, Game_GetPlayerName(), elapsed);
+    SimWorld_Free(w);
+    free(w);
     return completed;
 }
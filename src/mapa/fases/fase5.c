@@ -3,9 +3,20 @@
 #include "../../objects/lake.h"
 #include "../../ranking/ranking.h"
 #include "../../game/game.h"
+#include "../../game/sim_clock.h"
+#include "../../game/sim_input.h"
 #include "../../audio/theme.h"
+#include "../../render/render_scale.h"
+#include "../../render/particles.h"
+#include "../../render/frame_capture.h"
+#include "../../interface/text_cache.h"
 #include "../../interface/pause.h"
 #include "phase_common.h"
+#include "lake_renderer.h"
+#include "lake_index.h"
+#include "trigger_world.h"
+#include "tilemap_renderer.h"
+#include "collision_grid.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -102,48 +113,6 @@ static int ParseLakeSegments(const char* tmxPath, LakeSegment* out, int cap) {
     return count;
 }
 
-static void DrawLakes(const LakeSegment* segs, int count,
-                      const LakeAnimFrames* agua,
-                      const LakeAnimFrames* fogo,
-                      const LakeAnimFrames* terra,
-                      const LakeAnimFrames* acido) {
-    for (int i = 0; i < count; ++i) {
-        const LakeSegment* seg = &segs[i];
-        const LakeAnimFrames* anim = NULL;
-        if (seg->type == LAKE_WATER) anim = agua;
-        else if (seg->type == LAKE_FIRE) anim = fogo;
-        else if (seg->type == LAKE_EARTH) anim = terra;
-        else if (seg->type == LAKE_POISON) anim = acido;
-
-        const Texture2D* frame = anim ? PhasePickLakeFrame(anim, seg->part) : NULL;
-        if (frame && frame->id != 0) {
-            if (seg->part == PART_MIDDLE) {
-                float tile = seg->rect.height;
-                int tiles = (int)floorf(seg->rect.width / tile);
-                float x = seg->rect.x;
-                for (int t = 0; t < tiles; ++t) {
-                    Rectangle dst = { x, seg->rect.y, tile, seg->rect.height };
-                    DrawTexturePro(*frame, (Rectangle){0,0,(float)frame->width,(float)frame->height},
-                                   dst, (Vector2){0,0}, 0.0f, WHITE);
-                    x += tile;
-                }
-                float rest = seg->rect.width - tiles * tile;
-                if (rest > 0.1f) {
-                    Rectangle dst = { x, seg->rect.y, rest, seg->rect.height };
-                    DrawTexturePro(*frame, (Rectangle){0,0,(float)frame->width,(float)frame->height},
-                                   dst, (Vector2){0,0}, 0.0f, WHITE);
-                }
-            } else {
-                DrawTexturePro(*frame, (Rectangle){0,0,(float)frame->width,(float)frame->height},
-                               seg->rect, (Vector2){0,0}, 0.0f, WHITE);
-            }
-        } else {
-            Color fallback = (seg->type == LAKE_POISON) ? (Color){60,180,60,230} : (Color){90,90,90,200};
-            DrawRectangleRec(seg->rect, fallback);
-        }
-    }
-}
-
 static Vector2 CollectSpawnCenter(const char* tmx, const char* name, Vector2 fallback) {
     Rectangle rect[2];
     if (ParseRectsFromGroup(tmx, name, rect, 2) > 0) {
@@ -161,18 +130,10 @@ static Rectangle CollectDoor(const char* tmx, const char* name) {
     return (Rectangle){0};
 }
 
-static bool PlayersAtDoors(const Rectangle* doorTerra, const Rectangle* doorFogo,
-                           const Rectangle* doorAgua, const Player* earthboy,
-                           const Player* fireboy, const Player* watergirl) {
-    return PhaseCheckDoor(doorTerra, earthboy) &&
-           PhaseCheckDoor(doorFogo, fireboy) &&
-           PhaseCheckDoor(doorAgua, watergirl);
-}
-
 bool Fase5(void) {
     const char* tmx = "assets/maps/fase5/fase5.tmx";
-    Texture2D mapTex = LoadTexture("assets/maps/fase5/fase5.png");
-    if (mapTex.id == 0) {
+    PhaseBackground background;
+    if (!PhaseBackgroundLoad(&background, tmx, "assets/maps/fase5/fase5.png")) {
         printf("Erro: nao consegui carregar assets/maps/fase5/fase5.png\n");
         return false;
     }
@@ -186,18 +147,22 @@ bool Fase5(void) {
         colisas[colCount++].rect = buffer[i];
     }
 
+    CollisionGrid grid;
+    CollisionGrid_Build(&grid, colisas, colCount, COLLISION_GRID_CELL);
+
     LakeSegment lakes[MAX_LAKE_SEGS];
     int lakeCount = ParseLakeSegments(tmx, lakes, MAX_LAKE_SEGS);
 
-    LakeAnimFrames animAgua = {0}, animFogo = {0}, animTerra = {0}, animAcido = {0};
-    LoadLakeSet_Agua(&animAgua);
-    LoadLakeSet_Fogo(&animFogo);
-    LoadLakeSet_Terra(&animTerra);
-    LoadLakeSet_Acido(&animAcido);
+    LakeRenderer lakeRenderer;
+    LakeRendererLoad(&lakeRenderer, lakes, lakeCount, 0.12f);
+    LakeIndex lakeIndex;
+    LakeIndex_Build(&lakeIndex, lakes, lakeCount);
+    Particles_Reset();
+    for (int i = 0; i < lakeCount; ++i) Particles_AddLakeEmitter(lakes[i].rect, lakes[i].type);
 
-    Vector2 spawnEarthPos = CollectSpawnCenter(tmx, "spawnTerra", (Vector2){300, mapTex.height - 120});
-    Vector2 spawnFirePos  = CollectSpawnCenter(tmx, "spawnFogo",  (Vector2){400, mapTex.height - 120});
-    Vector2 spawnWaterPos = CollectSpawnCenter(tmx, "spawnAgua",  (Vector2){500, mapTex.height - 120});
+    Vector2 spawnEarthPos = CollectSpawnCenter(tmx, "spawnTerra", (Vector2){300, background.height - 120});
+    Vector2 spawnFirePos  = CollectSpawnCenter(tmx, "spawnFogo",  (Vector2){400, background.height - 120});
+    Vector2 spawnWaterPos = CollectSpawnCenter(tmx, "spawnAgua",  (Vector2){500, background.height - 120});
 
     Rectangle doorEarth = CollectDoor(tmx, "portaTerra");
     Rectangle doorFire  = CollectDoor(tmx, "portaFogo");
@@ -212,81 +177,100 @@ bool Fase5(void) {
     watergirl.rect.x= spawnWaterPos.x; watergirl.rect.y= spawnWaterPos.y;
 
     Camera2D cam = {0};
-    cam.target = (Vector2){mapTex.width / 2.0f, mapTex.height / 2.0f};
+    cam.target = (Vector2){background.width / 2.0f, background.height / 2.0f};
     cam.offset = (Vector2){GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
     cam.zoom = 1.0f;
 
     bool completed = false;
     bool debug = false;
     float elapsed = 0.0f;
+    float lakeTime = 0.0f;
     SetTargetFPS(60);
 
+    // Cada porta só enxerga o próprio jogador; a fase acaba com as três ocupadas ao mesmo tempo
+    TriggerWorld triggers;
+    TriggerWorld_Init(&triggers);
+    int doorTrigger[3];
+    doorTrigger[PHASE_EARTH] = TriggerWorld_Add(&triggers, doorEarth, 1u << PHASE_EARTH, NULL, NULL);
+    doorTrigger[PHASE_FIRE]  = TriggerWorld_Add(&triggers, doorFire,  1u << PHASE_FIRE,  NULL, NULL);
+    doorTrigger[PHASE_WATER] = TriggerWorld_Add(&triggers, doorWater, 1u << PHASE_WATER, NULL, NULL);
+
+    SimClock simClock;
+    SimClock_Start(&simClock);
+
     while (!WindowShouldClose()) {
         Theme_Update();
+        RenderScale_Update();
+        FrameCapture_Update();
         float dt = GetFrameTime();
-        elapsed += dt;
+        lakeTime += dt;
+        Particles_Update(dt);
         if (IsKeyPressed(KEY_TAB)) debug = !debug;
 
-        if (IsKeyPressed(KEY_ESCAPE)) {
-            PauseResult pr = ShowPauseMenu();
-            if (pr == PAUSE_TO_MAP) { completed = false; break; }
-            if (pr == PAUSE_TO_MENU) { Game_SetReturnToMenu(true); completed = false; break; }
-        }
-
-        UpdatePlayer(&earthboy, (Rectangle){0, mapTex.height, mapTex.width, 200}, KEY_J, KEY_L, KEY_I);
-        UpdatePlayer(&fireboy,  (Rectangle){0, mapTex.height, mapTex.width, 200}, KEY_LEFT, KEY_RIGHT, KEY_UP);
-        UpdatePlayer(&watergirl,(Rectangle){0, mapTex.height, mapTex.width, 200}, KEY_A, KEY_D, KEY_W);
-
         Player* players[3] = { &earthboy, &fireboy, &watergirl };
-        PhaseResolvePlayersVsWorld(players, 3, colisas, colCount, PHASE_STEP_HEIGHT);
-
-        bool respawnAll = false;
-        for (int p = 0; p < 3 && !respawnAll; ++p) {
-            Player* pl = players[p];
-            LakeType target = (p == 0) ? LAKE_EARTH : (p == 1 ? LAKE_FIRE : LAKE_WATER);
-            for (int i = 0; i < lakeCount; ++i) {
-                Lake temp = { lakes[i].rect, lakes[i].type, (Color){0} };
-                if (LakeHandlePlayer(&temp, pl, target)) {
+        bool finishedByDoors = false;
+        // Física em passo fixo: o número de ticks depende só do tempo real, não do FPS
+        int ticks = SimClock_Advance(&simClock, dt);
+        for (int tick = 0; tick < ticks; ++tick) {
+            SimClock_Tick(&simClock);
+            UpdatePlayer(&earthboy, (Rectangle){0, background.height, background.width, 200}, KEY_J, KEY_L, KEY_I);
+            UpdatePlayer(&fireboy,  (Rectangle){0, background.height, background.width, 200}, KEY_LEFT, KEY_RIGHT, KEY_UP);
+            UpdatePlayer(&watergirl,(Rectangle){0, background.height, background.width, 200}, KEY_A, KEY_D, KEY_W);
+
+            PhaseResolvePlayersVsWorld(players, 3, &grid, PHASE_STEP_HEIGHT);
+
+            bool respawnAll = false;
+            for (int p = 0; p < 3 && !respawnAll; ++p) {
+                Player* pl = players[p];
+                LakeType target = (p == 0) ? LAKE_EARTH : (p == 1 ? LAKE_FIRE : LAKE_WATER);
+                LakeType hit;
+                if (LakeIndex_Query(&lakeIndex, pl->rect, target, &hit) == LAKE_VERDICT_LETHAL) {
+                    Particles_BurstDeath(pl->rect, hit);
                     respawnAll = true;
-                    break;
                 }
             }
-        }
-        if (respawnAll) {
-            earthboy.rect.x = spawnEarthPos.x; earthboy.rect.y = spawnEarthPos.y;
-            fireboy.rect.x  = spawnFirePos.x;  fireboy.rect.y  = spawnFirePos.y;
-            watergirl.rect.x= spawnWaterPos.x; watergirl.rect.y= spawnWaterPos.y;
-            earthboy.velocity = fireboy.velocity = watergirl.velocity = (Vector2){0,0};
-            earthboy.isJumping = fireboy.isJumping = watergirl.isJumping = false;
-            continue;
-        }
+            if (respawnAll) {
+                earthboy.rect.x = spawnEarthPos.x; earthboy.rect.y = spawnEarthPos.y;
+                fireboy.rect.x  = spawnFirePos.x;  fireboy.rect.y  = spawnFirePos.y;
+                watergirl.rect.x= spawnWaterPos.x; watergirl.rect.y= spawnWaterPos.y;
+                earthboy.velocity = fireboy.velocity = watergirl.velocity = (Vector2){0,0};
+                earthboy.isJumping = fireboy.isJumping = watergirl.isJumping = false;
+                continue;
+            }
 
-        bool finishedByDoors = PlayersAtDoors(&doorEarth, &doorFire, &doorWater, &earthboy, &fireboy, &watergirl);
+            TriggerWorld_Update(&triggers, players, 3);
+            finishedByDoors = true;
+            for (int p = 0; p < 3; ++p)
+                finishedByDoors = finishedByDoors && TriggerWorld_Contains(&triggers, doorTrigger[p], p);
+            if (finishedByDoors) break;
+        }
+        elapsed = SimClock_Seconds(&simClock);
+        if (completed) break;
 
         BeginDrawing();
         ClearBackground(BLACK);
-        BeginMode2D(cam);
-        DrawTexture(mapTex, 0, 0, WHITE);
+        RenderScale_BeginWorld();
+        BeginMode2D(RenderScale_WorldCamera(cam));
+        PhaseBackgroundDraw(&background, cam);
 
         bool insideOwn[3] = { false, false, false };
         for (int i = 0; i < 3; ++i) {
             LakeType target = (i == 0) ? LAKE_EARTH : (i == 1 ? LAKE_FIRE : LAKE_WATER);
-            insideOwn[i] = PhasePlayerInsideOwnLake(players[i], target, lakes, lakeCount);
+            insideOwn[i] = LakeIndex_Query(&lakeIndex, players[i]->rect, target, NULL) == LAKE_VERDICT_OWN;
         }
 
-        LakeAnimFrames* sets[4] = { &animAgua, &animFogo, &animTerra, &animAcido };
-        PhaseUpdateLakeAnimations(sets, 4, dt, 0.12f);
-
         if (insideOwn[0]) DrawPlayer(earthboy);
         if (insideOwn[1]) DrawPlayer(fireboy);
         if (insideOwn[2]) DrawPlayer(watergirl);
 
-        DrawLakes(lakes, lakeCount, &animAgua, &animFogo, &animTerra, &animAcido);
+        LakeRendererDraw(&lakeRenderer, lakeTime);
 
         if (!insideOwn[0]) DrawPlayer(earthboy);
         if (!insideOwn[1]) DrawPlayer(fireboy);
         if (!insideOwn[2]) DrawPlayer(watergirl);
 
+        Particles_Draw();
+
         if (debug) {
             for (int i = 0; i < colCount; ++i) DrawRectangleLinesEx(colisas[i].rect, 1, Fade(GREEN, 0.5f));
             if (doorEarth.width > 0 && doorEarth.height > 0) DrawRectangleLinesEx(doorEarth, 1, Fade(BROWN, 0.6f));
@@ -295,17 +279,29 @@ bool Fase5(void) {
         }
 
         EndMode2D();
-        DrawText(TextFormat("Tempo: %05.2f", elapsed), 30, 30, 26, WHITE);
+        RenderScale_EndWorld();
+        TextCache_Draw("Tempo: ", 30, 30, 26, WHITE);
+        TextCache_DrawClock(elapsed, false, 30 + MeasureText("Tempo: ", 26), 30, 26, WHITE);
+        Pause_FrameEnd();
+        FrameCapture_Frame();
         EndDrawing();
 
+        // ESC congela o frame que acabou de ser desenhado e só então abre o pause
+        if (Pause_Pending()) {
+            PauseResult pr = ShowPauseMenu();
+            if (pr == PAUSE_TO_MAP) { completed = false; break; }
+            if (pr == PAUSE_TO_MENU) { Game_SetReturnToMenu(true); completed = false; break; }
+        }
+
         if (finishedByDoors) { completed = true; break; }
     }
 
-    UnloadTexture(mapTex);
-    PhaseUnloadLakeSet(&animAgua);
-    PhaseUnloadLakeSet(&animFogo);
-    PhaseUnloadLakeSet(&animTerra);
-    PhaseUnloadLakeSet(&animAcido);
+    PhaseBackgroundUnload(&background);
+    CollisionGrid_Free(&grid);
+    LakeRendererUnload(&lakeRenderer);
+    LakeIndex_Free(&lakeIndex);
+    TriggerWorld_Free(&triggers);
+    Particles_Reset();
     UnloadPlayer(&earthboy);
     UnloadPlayer(&fireboy);
     UnloadPlayer(&watergirl);
@@ -0,0 +1,129 @@
+#include "force_field.h"
+#include <math.h>
+#include <string.h>
+#include "signal_graph.h"
+#include "../../objects/box.h"
+#include "../../game/sim_fixed.h"
+
+void ForceFieldWorld_Init(ForceFieldWorld* w) {
+    memset(w, 0, sizeof(*w));
+}
+
+void ForceFieldWorld_Free(ForceFieldWorld* w) {
+    CollisionGrid_Free(&w->grid);
+    memset(w, 0, sizeof(*w));
+}
+
+int ForceFieldWorld_Add(ForceFieldWorld* w, Rectangle area, Vector2 direction, float strength,
+                        float maxSpeed, ForceFalloff falloff, int signal) {
+    if (w->count >= FORCE_FIELD_MAX || area.width <= 0 || area.height <= 0) return -1;
+    int id = w->count++;
+    w->volumes[id].rect = area;
+    w->fields[id] = (ForceField){ direction, strength, maxSpeed, falloff, signal, false };
+    ForceFieldWorld_SetActive(w, id, signal < 0);
+    w->gridDirty = true;
+    return id;
+}
+
+void ForceFieldWorld_SetActive(ForceFieldWorld* w, int id, bool active) {
+    if (id < 0 || id >= w->count || w->fields[id].active == active) return;
+    w->fields[id].active = active;
+    w->activeCount += active ? 1 : -1;
+}
+
+bool ForceFieldWorld_Active(const ForceFieldWorld* w, int id) {
+    return id >= 0 && id < w->count && w->fields[id].active;
+}
+
+void ForceFieldWorld_SyncSignals(ForceFieldWorld* w, const SignalGraph* signals) {
+    for (int i = 0; i < w->count; ++i) {
+        if (w->fields[i].signal >= 0) ForceFieldWorld_SetActive(w, i, SignalGraph_Output(signals, w->fields[i].signal));
+    }
+}
+
+// 1 na boca, caindo até 0 na ponta oposta (medido no centro do corpo)
+static float FalloffFactor(const ForceField* f, Rectangle area, Rectangle body) {
+    if (f->falloff == FORCE_FALLOFF_NONE) return 1.0f;
+    Vector2 d = f->direction;
+    float mouthX = d.x >= 0.0f ? area.x : area.x + area.width;
+    float mouthY = d.y >= 0.0f ? area.y : area.y + area.height;
+    float length = area.width * fabsf(d.x) + area.height * fabsf(d.y);
+    if (length <= 0.0f) return 1.0f;
+    float cx = body.x + body.width * 0.5f, cy = body.y + body.height * 0.5f;
+    float t = ((cx - mouthX) * d.x + (cy - mouthY) * d.y) / length;
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    return 1.0f - t;
+}
+
+// Soma o empurrão num eixo e limita a velocidade no sentido dele
+static float PushAxis(float v, float accel, float dir, float maxSpeed) {
+    if (dir == 0.0f) return v;
+    SimNum s = SimNum_FromFloat(v) + SimNum_FromFloat(accel * dir);
+    if (maxSpeed > 0.0f) {
+        SimNum cap = SimNum_FromFloat(maxSpeed * fabsf(dir));
+        if (dir > 0.0f && s > cap) s = cap;
+        if (dir < 0.0f && s < -cap) s = -cap;
+    }
+    return SimNum_ToFloat(s);
+}
+
+// Campos cuja área toca body (a grade é refeita só depois de um Add)
+static int QueryFields(ForceFieldWorld* w, Rectangle body, int* near) {
+    if (w->gridDirty) {
+        CollisionGrid_Free(&w->grid);
+        CollisionGrid_Build(&w->grid, w->volumes, w->count, COLLISION_GRID_CELL);
+        w->gridDirty = false;
+    }
+    return CollisionGrid_Query(&w->grid, body, near, FORCE_FIELD_MAX);
+}
+
+bool ForceFieldWorld_Apply(ForceFieldWorld* w, Rectangle body, Vector2* velocity) {
+    if (w->activeCount == 0) return false;
+    int near[FORCE_FIELD_MAX];
+    int n = QueryFields(w, body, near);
+    bool pushed = false;
+    for (int i = 0; i < n; ++i) {
+        const ForceField* f = &w->fields[near[i]];
+        if (!f->active) continue;
+        float accel = f->strength * FalloffFactor(f, w->volumes[near[i]].rect, body);
+        if (accel == 0.0f) continue;
+        velocity->x = PushAxis(velocity->x, accel, f->direction.x, f->maxSpeed);
+        velocity->y = PushAxis(velocity->y, accel, f->direction.y, f->maxSpeed);
+        pushed = true;
+    }
+    return pushed;
+}
+
+void ForceFieldWorld_ApplyPlayers(ForceFieldWorld* w, Player** players, int count) {
+    if (w->activeCount == 0) return;
+    for (int p = 0; p < count; ++p) {
+        if (players[p]) ForceFieldWorld_Apply(w, players[p]->rect, &players[p]->velocity);
+    }
+}
+
+// Só um empurrão para baixo (sem componente lateral) não tem como tirar a caixa do apoio
+static bool WakesResting(ForceFieldWorld* w, Rectangle body) {
+    int near[FORCE_FIELD_MAX];
+    int n = QueryFields(w, body, near);
+    for (int i = 0; i < n; ++i) {
+        const ForceField* f = &w->fields[near[i]];
+        if (f->active && (f->direction.y < 0.0f || f->direction.x != 0.0f)) return true;
+    }
+    return false;
+}
+
+void ForceFieldWorld_ApplyBoxes(ForceFieldWorld* w, Box* boxes, int count) {
+    if (w->activeCount == 0) return;
+    for (int b = 0; b < count; ++b) {
+        Box* box = &boxes[b];
+        if (box->sleeping) {
+            if (!WakesResting(w, box->rect)) continue;
+            BoxWake(box);
+        }
+        Vector2 v = { box->velX, box->velY };
+        if (!ForceFieldWorld_Apply(w, box->rect, &v)) continue;
+        box->velX = v.x;
+        box->velY = v.y;
+    }
+}
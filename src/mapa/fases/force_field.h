@@ -0,0 +1,67 @@
+#ifndef FORCE_FIELD_H
+#define FORCE_FIELD_H
+
+#include <stdbool.h>
+#include "../../game/sim_types.h"
+#include "phase_common.h"
+#include "collision_grid.h"
+
+#define FORCE_FIELD_MAX  32
+
+struct SignalGraph;
+struct Box;
+
+typedef enum ForceFalloff {
+    FORCE_FALLOFF_NONE = 0,   // mesma força na área toda
+    FORCE_FALLOFF_LINEAR      // força cheia na boca, zero na ponta oposta
+} ForceFalloff;
+
+// Região que soma velocidade a quem estiver dentro (ventiladores, correntes de
+// vento). direction aponta para onde empurra; a boca é o lado de onde o ar sai
+// (para um campo que sobe, a borda de baixo). maxSpeed limita a velocidade na
+// direção do empurrão em cada eixo (0 = sem limite).
+typedef struct ForceField {
+    Vector2 direction;        // unitário: (0,-1) sobe, (0,1) desce, (±1,0) vento lateral
+    float strength;           // px/tick² na boca
+    float maxSpeed;
+    ForceFalloff falloff;
+    int signal;               // saída do SignalGraph que liga o campo (-1 = sempre ligado)
+    bool active;
+} ForceField;
+
+// Campos fixos registrados na carga e indexados numa grade própria (montada na
+// primeira aplicação depois de um Add): cada corpo consulta só os campos que
+// tocam o seu retângulo, então o custo não cresce com o número de ventiladores.
+typedef struct ForceFieldWorld {
+    int count;
+    int activeCount;
+    Colisao volumes[FORCE_FIELD_MAX];
+    ForceField fields[FORCE_FIELD_MAX];
+    CollisionGrid grid;
+    bool gridDirty;
+} ForceFieldWorld;
+
+void ForceFieldWorld_Init(ForceFieldWorld* w);
+void ForceFieldWorld_Free(ForceFieldWorld* w);
+
+// Devolve o id do campo, ou -1 se a área é vazia ou não há espaço. Sem sinal o
+// campo já nasce ligado; com sinal fica desligado até ForceFieldWorld_SyncSignals.
+int ForceFieldWorld_Add(ForceFieldWorld* w, Rectangle area, Vector2 direction, float strength,
+                        float maxSpeed, ForceFalloff falloff, int signal);
+void ForceFieldWorld_SetActive(ForceFieldWorld* w, int id, bool active);
+bool ForceFieldWorld_Active(const ForceFieldWorld* w, int id);
+// Liga/desliga cada campo com sinal pela saída correspondente do grafo
+void ForceFieldWorld_SyncSignals(ForceFieldWorld* w, const struct SignalGraph* signals);
+
+// Soma em velocity o empurrão de todos os campos ligados que tocam body, em ordem
+// de registro. Serve para qualquer corpo (um ponto é um retângulo de tamanho 0).
+// Devolve true se algum campo agiu.
+bool ForceFieldWorld_Apply(ForceFieldWorld* w, Rectangle body, Vector2* velocity);
+
+// Uma passada sobre os corpos da fase
+void ForceFieldWorld_ApplyPlayers(ForceFieldWorld* w, Player** players, int count);
+// Caixa dormindo só acorda por um campo que empurra contra a gravidade ou para o
+// lado; um campo que só empurra para baixo não tira a caixa do apoio.
+void ForceFieldWorld_ApplyBoxes(ForceFieldWorld* w, struct Box* boxes, int count);
+
+#endif
@@ -0,0 +1,60 @@
+#include "kinematic_world.h"
+#include <math.h>
+#include <string.h>
+
+void KinematicWorld_Init(KinematicWorld* w, CollisionGrid* grid) {
+    memset(w, 0, sizeof(*w));
+    w->grid = grid;
+}
+
+int KinematicWorld_Add(KinematicWorld* w, int colIndex) {
+    if (w->count >= KINEMATIC_MAX || !w->grid || colIndex < 0 || colIndex >= w->grid->count) return -1;
+    int id = w->count++;
+    w->colIndex[id] = colIndex;
+    w->velocity[id] = (Vector2){0, 0};
+    w->riders[id] = 0;
+    CollisionGrid_SetDynamic(w->grid, colIndex);
+    return id;
+}
+
+Rectangle KinematicWorld_Rect(const KinematicWorld* w, int id) {
+    if (id < 0 || id >= w->count) return (Rectangle){0};
+    return w->grid->rects[w->colIndex[id]].rect;
+}
+
+unsigned int KinematicWorld_Riders(const KinematicWorld* w, int id) {
+    if (id < 0 || id >= w->count) return 0;
+    return w->riders[id];
+}
+
+// Em pé no topo: sobrepõe na horizontal, pé encostado no topo e sem estar subindo
+static bool StandingOn(const Player* pl, Rectangle top) {
+    if (pl->velocity.y < 0.0f) return false;
+    if (pl->rect.x + pl->rect.width <= top.x || pl->rect.x >= top.x + top.width) return false;
+    return fabsf(pl->rect.y + pl->rect.height - top.y) <= KINEMATIC_RIDE_TOLERANCE;
+}
+
+void KinematicWorld_Move(KinematicWorld* w, int id, Rectangle to, Player** bodies, int bodyCount) {
+    if (id < 0 || id >= w->count) return;
+    Rectangle from = KinematicWorld_Rect(w, id);
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    w->velocity[id] = (Vector2){ dx, dy };
+
+    unsigned int riders = 0;
+    for (int b = 0; b < bodyCount && b < 8; ++b) {
+        if (bodies[b] && from.width > 0 && StandingOn(bodies[b], from)) riders |= 1u << b;
+    }
+    w->riders[id] = (unsigned char)riders;
+
+    if (dx != 0.0f || dy != 0.0f) CollisionGrid_MoveDynamic(w->grid, w->colIndex[id], to);
+
+    for (int b = 0; riders; ++b, riders >>= 1) {
+        if (!(riders & 1u)) continue;
+        Player* pl = bodies[b];
+        pl->rect.x += dx;
+        pl->rect.y = to.y - pl->rect.height;
+        pl->velocity.y = 0;
+        pl->isJumping = false;
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef KINEMATIC_WORLD_H
+#define KINEMATIC_WORLD_H
+
+#include <stdbool.h>
+#include "../../game/sim_types.h"
+#include "phase_common.h"
+#include "collision_grid.h"
+
+#define KINEMATIC_MAX            8
+#define KINEMATIC_RIDE_TOLERANCE 2.0f   // px entre o pé e o topo que ainda conta como "em cima"
+
+// Corpos cinemáticos (barras, elevadores): entradas dinâmicas do vetor de colisões
+// da fase, movidas por código e não pela física. Os jogadores batem neles pela
+// resolução normal contra o mundo; ao mover, quem estava em pé no topo é levado
+// junto (deltaX/deltaY) e fica registrado em riders.
+typedef struct KinematicWorld {
+    CollisionGrid* grid;
+    int count;
+    int colIndex[KINEMATIC_MAX];        // entrada em grid->rects
+    Vector2 velocity[KINEMATIC_MAX];    // deslocamento do último tick
+    unsigned char riders[KINEMATIC_MAX]; // bit p = corpo p carregado no último tick
+} KinematicWorld;
+
+void KinematicWorld_Init(KinematicWorld* w, CollisionGrid* grid);
+
+// Marca a colisão como dinâmica na grade; devolve o id do corpo (-1 se não couber)
+int KinematicWorld_Add(KinematicWorld* w, int colIndex);
+
+// Leva o corpo para to neste tick, carregando quem estava em pé sobre ele
+void KinematicWorld_Move(KinematicWorld* w, int id, Rectangle to, Player** bodies, int bodyCount);
+
+Rectangle KinematicWorld_Rect(const KinematicWorld* w, int id);
+unsigned int KinematicWorld_Riders(const KinematicWorld* w, int id);
+
+#endif
@@ -0,0 +1,87 @@
+#include "lake_index.h"
+#include "../../game/sim_rect.h"
+#include "../../structure/quicksort.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int CompareSpanX(const void* a, const void* b) {
+    float xa = ((const LakeSpan*)a)->rect.x;
+    float xb = ((const LakeSpan*)b)->rect.x;
+    return (xa > xb) - (xa < xb);
+}
+
+bool LakeIndex_Build(LakeIndex* idx, const LakeSegment* segs, int segCount) {
+    memset(idx, 0, sizeof(*idx));
+    int counts[LAKE_INDEX_TYPES] = { 0 };
+    for (int i = 0; i < segCount; ++i) {
+        if ((int)segs[i].type >= 0 && (int)segs[i].type < LAKE_INDEX_TYPES) counts[segs[i].type]++;
+    }
+
+    for (int t = 0; t < LAKE_INDEX_TYPES; ++t) {
+        if (counts[t] == 0) continue;
+        LakeTypeSpans* ts = &idx->byType[t];
+        ts->spans = (LakeSpan*)malloc(sizeof(LakeSpan) * (size_t)counts[t]);
+        ts->maxRight = (float*)malloc(sizeof(float) * (size_t)counts[t]);
+        if (!ts->spans || !ts->maxRight) { LakeIndex_Free(idx); return false; }
+    }
+    for (int i = 0; i < segCount; ++i) {
+        int t = (int)segs[i].type;
+        if (t < 0 || t >= LAKE_INDEX_TYPES) continue;
+        LakeTypeSpans* ts = &idx->byType[t];
+        ts->spans[ts->count++] = (LakeSpan){ segs[i].rect, LakeKillBand(segs[i].rect) };
+    }
+
+    for (int t = 0; t < LAKE_INDEX_TYPES; ++t) {
+        LakeTypeSpans* ts = &idx->byType[t];
+        if (ts->count == 0) continue;
+        quicksort(ts->spans, ts->count, (int)sizeof(LakeSpan), CompareSpanX);
+        float right = ts->spans[0].rect.x + ts->spans[0].rect.width;
+        for (int i = 0; i < ts->count; ++i) {
+            float r = ts->spans[i].rect.x + ts->spans[i].rect.width;
+            if (r > right) right = r;
+            ts->maxRight[i] = right;
+        }
+    }
+    return true;
+}
+
+void LakeIndex_Free(LakeIndex* idx) {
+    for (int t = 0; t < LAKE_INDEX_TYPES; ++t) {
+        free(idx->byType[t].spans);
+        free(idx->byType[t].maxRight);
+    }
+    memset(idx, 0, sizeof(*idx));
+}
+
+// Primeiro span cujo x final (acumulado) passa de x
+static int FirstReaching(const LakeTypeSpans* ts, float x) {
+    int lo = 0, hi = ts->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (ts->maxRight[mid] > x) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+LakeVerdict LakeIndex_Query(const LakeIndex* idx, Rectangle body, LakeType element, LakeType* hitType) {
+    float right = body.x + body.width;
+    bool own = false;
+    for (int t = 0; t < LAKE_INDEX_TYPES; ++t) {
+        const LakeTypeSpans* ts = &idx->byType[t];
+        if (ts->count == 0) continue;
+        bool mine = (t == (int)element) && t != LAKE_POISON;
+        for (int i = FirstReaching(ts, body.x); i < ts->count && ts->spans[i].rect.x < right; ++i) {
+            const LakeSpan* sp = &ts->spans[i];
+            if (mine) {
+                if (!own && SimRectsOverlap(body, sp->rect)) own = true;
+                continue;
+            }
+            if (LakeKillBandHit(sp->kill, body)) {
+                if (hitType) *hitType = (LakeType)t;
+                return LAKE_VERDICT_LETHAL;
+            }
+        }
+    }
+    return own ? LAKE_VERDICT_OWN : LAKE_VERDICT_SAFE;
+}
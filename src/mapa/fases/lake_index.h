@@ -0,0 +1,43 @@
+#ifndef LAKE_INDEX_H
+#define LAKE_INDEX_H
+
+#include <stdbool.h>
+#include "../../game/sim_types.h"
+#include "phase_common.h"
+
+#define LAKE_INDEX_TYPES 4   // LAKE_WATER .. LAKE_POISON
+
+typedef enum LakeVerdict {
+    LAKE_VERDICT_SAFE = 0,
+    LAKE_VERDICT_OWN,      // dentro de um lago do próprio elemento
+    LAKE_VERDICT_LETHAL
+} LakeVerdict;
+
+typedef struct LakeSpan {
+    Rectangle rect;   // segmento inteiro (para "dentro do próprio lago")
+    Rectangle kill;   // faixa letal do topo, calculada na carga
+} LakeSpan;
+
+// Segmentos de lago separados por tipo e ordenados pelo x inicial. maxRight[i] é o
+// maior x final entre spans[0..i] (não decresce), então a busca binária acha o
+// primeiro segmento que pode alcançar o jogador e a varredura para no primeiro
+// que começa depois dele.
+typedef struct LakeTypeSpans {
+    LakeSpan* spans;
+    float* maxRight;
+    int count;
+} LakeTypeSpans;
+
+typedef struct LakeIndex {
+    LakeTypeSpans byType[LAKE_INDEX_TYPES];
+} LakeIndex;
+
+bool LakeIndex_Build(LakeIndex* idx, const LakeSegment* segs, int segCount);
+void LakeIndex_Free(LakeIndex* idx);
+
+// Mesmo critério de LakeHandlePlayer (letal) e de "encostou num lago do próprio
+// elemento" (OWN, usado para desenhar o jogador por trás), só que sem passar
+// por todos os segmentos. hitType (opcional) recebe o tipo do lago letal.
+LakeVerdict LakeIndex_Query(const LakeIndex* idx, Rectangle body, LakeType element, LakeType* hitType);
+
+#endif
@@ -0,0 +1,237 @@
+#include "lake_renderer.h"
+#include "rlgl.h"
+#include "../../render/render_stats.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char* pattern;
+    int first, last;
+} LakeFramePattern;
+
+// [tipo][parte][tentativa] — a segunda tentativa cobre nomes antigos dos PNGs
+static const LakeFramePattern kLakeFrames[LAKE_ATLAS_TYPES][LAKE_ATLAS_PARTS][2] = {
+    [LAKE_WATER] = {
+        [PART_LEFT]   = { { "assets/map/agua/esquerdo/pixil-frame-%d.png", 0, 15 } },
+        [PART_MIDDLE] = { { "assets/map/agua/meio/pixil-frame-%d.png",     0, 15 } },
+        [PART_RIGHT]  = { { "assets/map/agua/direito/pixil-frame-%d.png",  0, 15 } },
+    },
+    [LAKE_FIRE] = {
+        [PART_LEFT]   = { { "assets/map/fogo/esquerdo/Esquerda%d.png", 1, 32 },
+                          { "assets/map/fogo/esquerdo/pixil-frame-%d.png", 0, 31 } },
+        [PART_MIDDLE] = { { "assets/map/fogo/meio/Meio%d.png", 1, 32 },
+                          { "assets/map/fogo/meio/pixil-frame-%d.png", 0, 31 } },
+        [PART_RIGHT]  = { { "assets/map/fogo/direito/Direita%d.png", 1, 32 },
+                          { "assets/map/fogo/direito/pixil-frame-%d.png", 0, 31 } },
+    },
+    [LAKE_EARTH] = {
+        [PART_LEFT]   = { { "assets/map/terra/esquerdo/pixil-frame-%d.png", 0, 15 } },
+        [PART_MIDDLE] = { { "assets/map/terra/meio/pixil-frame-%d.png",     0, 15 } },
+        [PART_RIGHT]  = { { "assets/map/terra/direito/pixil-frame-%d.png",  0, 15 } },
+    },
+    [LAKE_POISON] = {
+        [PART_LEFT]   = { { "assets/map/acido/esquerdo/pixil-frame-%d.png", 0, 15 } },
+        [PART_MIDDLE] = { { "assets/map/acido/meio/pixil-frame-%d.png",     0, 15 } },
+        [PART_RIGHT]  = { { "assets/map/acido/direito/pixil-frame-%d.png",  0, 15 } },
+    },
+};
+
+// Desloca a coordenada U para a coluna do quadro atual; o quad sempre aponta para a coluna 0.
+static const char* kLakeFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform float time;\n"
+    "uniform float frameTime;\n"
+    "uniform float frameCount;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float frame = mod(floor(time / frameTime), frameCount);\n"
+    "    vec2 uv = vec2(fragTexCoord.x + frame / frameCount, fragTexCoord.y);\n"
+    "    finalColor = texture(texture0, uv) * colDiffuse * fragColor;\n"
+    "}\n";
+
+static int LoadImageFramesRange(Image* arr, int max, const char* pattern, int startIdx, int endIdx) {
+    int count = 0; bool started = false;
+    for (int i = startIdx; i <= endIdx && count < max; ++i) {
+        char path[256]; snprintf(path, sizeof(path), pattern, i);
+        if (!FileExists(path)) { if (started) break; else continue; }
+        Image img = LoadImage(path);
+        if (img.data != NULL) { arr[count++] = img; started = true; }
+        else if (started) break;
+    }
+    return count;
+}
+
+static int Gcd(int a, int b) {
+    while (b != 0) { int t = a % b; a = b; b = t; }
+    return a;
+}
+
+static int LakeRow(LakeType type, LakePart part) {
+    return (int)type * LAKE_ATLAS_PARTS + (int)part;
+}
+
+static void BuildAtlas(LakeRenderer* r) {
+    Image frames[LAKE_ATLAS_ROWS][LAKE_ATLAS_MAX_COLS];
+    int counts[LAKE_ATLAS_ROWS] = {0};
+    int typeFrames[LAKE_ATLAS_TYPES] = {0};
+
+    for (int t = 0; t < LAKE_ATLAS_TYPES; ++t) {
+        for (int p = 0; p < LAKE_ATLAS_PARTS; ++p) {
+            int row = LakeRow((LakeType)t, (LakePart)p);
+            for (int a = 0; a < 2 && counts[row] == 0; ++a) {
+                const LakeFramePattern* fp = &kLakeFrames[t][p][a];
+                if (!fp->pattern) continue;
+                counts[row] = LoadImageFramesRange(frames[row], LAKE_ATLAS_MAX_COLS, fp->pattern, fp->first, fp->last);
+            }
+            if (counts[row] > 0 && r->cellW <= 0.0f) {
+                r->cellW = (float)frames[row][0].width;
+                r->cellH = (float)frames[row][0].height;
+            }
+        }
+        // Mesmo critério de antes: o ciclo do tipo segue o meio, depois esquerda, depois direita
+        int mid = counts[LakeRow((LakeType)t, PART_MIDDLE)];
+        int left = counts[LakeRow((LakeType)t, PART_LEFT)];
+        int right = counts[LakeRow((LakeType)t, PART_RIGHT)];
+        typeFrames[t] = mid > 0 ? mid : (left > 0 ? left : right);
+    }
+
+    // Colunas = MMC dos ciclos, para que todos os tipos fechem o laço juntos com um único frameCount
+    int cols = 1, maxFrames = 1;
+    for (int t = 0; t < LAKE_ATLAS_TYPES; ++t) {
+        if (typeFrames[t] <= 0) continue;
+        if (typeFrames[t] > maxFrames) maxFrames = typeFrames[t];
+        cols = cols / Gcd(cols, typeFrames[t]) * typeFrames[t];
+        if (cols > LAKE_ATLAS_MAX_COLS) { cols = maxFrames; break; }
+    }
+    if (cols < maxFrames) cols = maxFrames;
+    r->frameCount = cols;
+
+    if (r->cellW > 0.0f && r->cellH > 0.0f) {
+        int cw = (int)r->cellW, ch = (int)r->cellH;
+        Image atlas = GenImageColor(cw * cols, ch * LAKE_ATLAS_ROWS, BLANK);
+        for (int t = 0; t < LAKE_ATLAS_TYPES; ++t) {
+            for (int p = 0; p < LAKE_ATLAS_PARTS; ++p) {
+                int row = LakeRow((LakeType)t, (LakePart)p);
+                if (counts[row] <= 0 || typeFrames[t] <= 0) continue;
+                for (int c = 0; c < cols; ++c) {
+                    const Image* src = &frames[row][(c % typeFrames[t]) % counts[row]];
+                    ImageDraw(&atlas, *src, (Rectangle){0, 0, (float)src->width, (float)src->height},
+                              (Rectangle){(float)(c * cw), (float)(row * ch), (float)cw, (float)ch}, WHITE);
+                }
+                r->rowLoaded[row] = true;
+            }
+        }
+        r->atlas = LoadTextureFromImage(atlas);
+        UnloadImage(atlas);
+    }
+
+    for (int row = 0; row < LAKE_ATLAS_ROWS; ++row)
+        for (int i = 0; i < counts[row]; ++i) UnloadImage(frames[row][i]);
+}
+
+static void PushQuad(LakeRenderer* r, int cap, Rectangle src, Rectangle dst) {
+    if (r->quadCount >= cap) return;
+    r->quads[r->quadCount].src = src;
+    r->quads[r->quadCount].dst = dst;
+    r->quadCount++;
+}
+
+bool LakeRendererLoad(LakeRenderer* r, const LakeSegment* segs, int segCount, float frameTime) {
+    if (!r) return false;
+    memset(r, 0, sizeof(*r));
+    r->frameTime = frameTime > 0.0f ? frameTime : 0.12f;
+    BuildAtlas(r);
+
+    // Conta os quads: o meio é repetido em ladrilhos quadrados, como no desenho original
+    int cap = 0;
+    for (int i = 0; i < segCount; ++i) {
+        const LakeSegment* seg = &segs[i];
+        if (seg->part == PART_MIDDLE && seg->rect.height > 0.0f)
+            cap += (int)floorf(seg->rect.width / seg->rect.height) + 1;
+        else
+            cap += 1;
+    }
+    if (cap > 0) {
+        r->quads = (LakeQuad*)malloc(sizeof(LakeQuad) * (size_t)cap);
+        r->fallback = (Lake*)malloc(sizeof(Lake) * (size_t)segCount);
+        if (!r->quads || !r->fallback) { LakeRendererUnload(r); return false; }
+    }
+
+    for (int i = 0; i < segCount; ++i) {
+        const LakeSegment* seg = &segs[i];
+        int row = LakeRow(seg->type, seg->part);
+        if (r->atlas.id == 0 || !r->rowLoaded[row]) {
+            LakeInit(&r->fallback[r->fallbackCount++], seg->rect.x, seg->rect.y, seg->rect.width, seg->rect.height, seg->type);
+            continue;
+        }
+        Rectangle src = { 0.0f, row * r->cellH, r->cellW, r->cellH };
+        if (seg->part == PART_MIDDLE) {
+            float tile = seg->rect.height;
+            int tiles = (int)floorf(seg->rect.width / tile);
+            float x = seg->rect.x;
+            for (int t = 0; t < tiles; ++t) {
+                PushQuad(r, cap, src, (Rectangle){ x, seg->rect.y, tile, seg->rect.height });
+                x += tile;
+            }
+            float rest = seg->rect.width - tiles * tile;
+            if (rest > 0.1f) PushQuad(r, cap, src, (Rectangle){ x, seg->rect.y, rest, seg->rect.height });
+        } else {
+            PushQuad(r, cap, src, seg->rect);
+        }
+    }
+
+    if (r->atlas.id != 0) {
+        r->shader = LoadShaderFromMemory(NULL, kLakeFragmentShader);
+        // Em caso de falha a raylib devolve o shader padrão; seguimos com o deslocamento na CPU
+        r->shaderReady = r->shader.id != 0 && r->shader.id != rlGetShaderIdDefault();
+        if (r->shaderReady) {
+            float frameCount = (float)r->frameCount;
+            r->timeLoc = GetShaderLocation(r->shader, "time");
+            SetShaderValue(r->shader, GetShaderLocation(r->shader, "frameTime"), &r->frameTime, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(r->shader, GetShaderLocation(r->shader, "frameCount"), &frameCount, SHADER_UNIFORM_FLOAT);
+        }
+    }
+    return true;
+}
+
+void LakeRendererDraw(const LakeRenderer* r, float time) {
+    if (!r) return;
+    for (int i = 0; i < r->fallbackCount; ++i) LakeDraw(&r->fallback[i]);
+    if (r->atlas.id == 0 || r->quadCount == 0) return;
+
+    float offsetX = 0.0f;
+    if (r->shaderReady) {
+        SetShaderValue(r->shader, r->timeLoc, &time, SHADER_UNIFORM_FLOAT);
+        BeginShaderMode(r->shader);
+    } else {
+        int column = (int)(time / r->frameTime) % r->frameCount;
+        offsetX = column * r->cellW;
+    }
+
+    // Mesma textura e mesmo shader para todos os quads: a raylib agrupa tudo num único draw call
+    for (int i = 0; i < r->quadCount; ++i) {
+        Rectangle src = r->quads[i].src;
+        src.x += offsetX;
+        DrawTexturePro(r->atlas, src, r->quads[i].dst, (Vector2){0, 0}, 0.0f, WHITE);
+    }
+
+    if (r->shaderReady) {
+        RenderStats_Collect(); // EndShaderMode esvazia o lote
+        EndShaderMode();
+    }
+}
+
+void LakeRendererUnload(LakeRenderer* r) {
+    if (!r) return;
+    if (r->shaderReady) UnloadShader(r->shader);
+    if (r->atlas.id != 0) UnloadTexture(r->atlas);
+    free(r->quads);
+    free(r->fallback);
+    memset(r, 0, sizeof(*r));
+}
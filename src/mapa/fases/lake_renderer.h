@@ -0,0 +1,40 @@
+#ifndef LAKE_RENDERER_H
+#define LAKE_RENDERER_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "phase_common.h"
+
+// Linhas do atlas: uma por (tipo de lago x parte)
+#define LAKE_ATLAS_TYPES   4
+#define LAKE_ATLAS_PARTS   3
+#define LAKE_ATLAS_ROWS    (LAKE_ATLAS_TYPES * LAKE_ATLAS_PARTS)
+#define LAKE_ATLAS_MAX_COLS 32
+
+typedef struct LakeQuad {
+    Rectangle src;   // coluna 0 da linha (tipo, parte) no atlas
+    Rectangle dst;   // posição no mapa
+} LakeQuad;
+
+// Todos os quadros de lago (PNGs originais) são montados num único atlas na carga.
+// O fragment shader escolhe a coluna a partir do tempo, então não há timers de
+// animação na CPU e todos os lagos do mapa saem num único lote de quads.
+typedef struct LakeRenderer {
+    Texture2D atlas;
+    Shader shader;
+    bool shaderReady;
+    int timeLoc;
+    float frameTime;
+    int frameCount;                     // colunas do atlas
+    float cellW, cellH;
+    bool rowLoaded[LAKE_ATLAS_ROWS];
+
+    LakeQuad* quads;  int quadCount;    // malha estática construída na carga
+    Lake* fallback;   int fallbackCount; // segmentos sem arte (desenho sólido)
+} LakeRenderer;
+
+bool LakeRendererLoad(LakeRenderer* r, const LakeSegment* segs, int segCount, float frameTime);
+void LakeRendererDraw(const LakeRenderer* r, float time);
+void LakeRendererUnload(LakeRenderer* r);
+
+#endif
@@ -0,0 +1,44 @@
+// Texturas compartilhadas pelas fases (só no jogo com janela; o núcleo de
+// simulação em phase_common.c não carrega nada da GPU)
+#include "phase_common.h"
+#include <string.h>
+
+Texture2D LoadTextureIfExists(const char* path) {
+    if (!FileExists(path)) return (Texture2D){0};
+    return LoadTexture(path);
+}
+
+void PhaseLoadButtonSprites(ButtonSpriteSet* set) {
+    if (!set) return;
+    set->blue  = LoadTextureIfExists("assets/map/buttons/pixil-layer-bluebutton.png");
+    set->red   = LoadTextureIfExists("assets/map/buttons/pixil-layer-redbutton.png");
+    set->white = LoadTextureIfExists("assets/map/buttons/pixil-layer-whitebutton.png");
+    set->brown = LoadTextureIfExists("assets/map/buttons/pixil-layer-brownbutton.png");
+}
+
+void PhaseUnloadButtonSprites(ButtonSpriteSet* set) {
+    if (!set) return;
+    if (set->blue.id != 0)  UnloadTexture(set->blue);
+    if (set->red.id != 0)   UnloadTexture(set->red);
+    if (set->white.id != 0) UnloadTexture(set->white);
+    if (set->brown.id != 0) UnloadTexture(set->brown);
+    set->blue = set->red = set->white = set->brown = (Texture2D){0};
+}
+
+const Texture2D* PhasePickButtonSprite(const ButtonSpriteSet* set, const char* nameLower) {
+    if (!set) return NULL;
+    const Texture2D* match = NULL;
+    if (nameLower) {
+        if (strstr(nameLower, "branc") && set->white.id != 0) match = &set->white;
+        else if (strstr(nameLower, "azul") && set->blue.id != 0) match = &set->blue;
+        else if (strstr(nameLower, "verm") && set->red.id != 0) match = &set->red;
+        else if ((strstr(nameLower, "marr") || strstr(nameLower, "terra")) && set->brown.id != 0) match = &set->brown;
+    }
+    if (match) return match;
+
+    if (set->blue.id != 0)  return &set->blue;
+    if (set->red.id != 0)   return &set->red;
+    if (set->white.id != 0) return &set->white;
+    if (set->brown.id != 0) return &set->brown;
+    return NULL;
+}
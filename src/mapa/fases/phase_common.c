@@ -1,4 +1,7 @@
 #include "phase_common.h"
+#include "collision_grid.h"
+#include "../../game/sim_fixed.h"
+#include "../../game/sim_rect.h"
 #include <ctype.h>
 #include <float.h>
 #include <math.h>
@@ -7,9 +10,26 @@
 #include <string.h>
 #include <stdio.h>
 
+// Texto inteiro do arquivo (terminado em '\0'), lido com stdio para o núcleo
+// de simulação não depender da raylib; liberar com free
+static char* PhaseLoadText(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    char* text = NULL;
+    if (fseek(f, 0, SEEK_END) == 0) {
+        long size = ftell(f);
+        if (size >= 0 && fseek(f, 0, SEEK_SET) == 0 && (text = (char*)malloc((size_t)size + 1)) != NULL) {
+            size_t got = fread(text, 1, (size_t)size, f);
+            text[got] = '\0';
+        }
+    }
+    fclose(f);
+    return text;
+}
+
 int ParseRectsFromGroup(const char* tmxPath, const char* groupName, Rectangle* out, int cap) {
     int count = 0;
-    char* xml = LoadFileText(tmxPath);
+    char* xml = PhaseLoadText(tmxPath);
     if (!xml) return 0;
 
     const char* search = xml;
@@ -20,7 +40,7 @@ int ParseRectsFromGroup(const char* tmxPath, const char* groupName, Rectangle* o
         bool match = false;
         size_t len = (size_t)(tagClose - search);
         char* header = (char*)malloc(len + 1);
-        if (!header) { UnloadFileText(xml); return count; }
+        if (!header) { free(xml); return count; }
         memcpy(header, search, len);
         header[len] = '\0';
 
@@ -40,7 +60,7 @@ int ParseRectsFromGroup(const char* tmxPath, const char* groupName, Rectangle* o
                 float x=0,y=0,w=0,h=0;
                 sscanf(obj, "<object id=%*[^x]x=\"%f\" y=\"%f\" width=\"%f\" height=\"%f\"",
                        &x,&y,&w,&h);
-                if (w>0 && h>0 && count < cap) out[count++] = (Rectangle){x,y,w,h};
+                if (w>0 && h>0 && count < cap) out[count++] = SimQuantizeRect((Rectangle){x,y,w,h});
                 p = obj + 8;
             }
         }
@@ -48,7 +68,7 @@ int ParseRectsFromGroup(const char* tmxPath, const char* groupName, Rectangle* o
         search = groupEnd ? (groupEnd + 14) : (search + 11);
     }
 
-    UnloadFileText(xml);
+    free(xml);
     return count;
 }
 
@@ -61,6 +81,25 @@ int ParseRectsFromAny(const char* tmxPath, const char** names, int nNames,
     return total;
 }
 
+bool PhaseMapSize(const char* tmxPath, int* width, int* height) {
+    char* xml = PhaseLoadText(tmxPath);
+    if (!xml) return false;
+    int cols = 0, rows = 0, tileW = 0, tileH = 0;
+    const char* map = strstr(xml, "<map ");
+    if (map) {
+        const char* p;
+        if ((p = strstr(map, " width=\""))) sscanf(p, " width=\"%d\"", &cols);
+        if ((p = strstr(map, " height=\""))) sscanf(p, " height=\"%d\"", &rows);
+        if ((p = strstr(map, "tilewidth=\""))) sscanf(p, "tilewidth=\"%d\"", &tileW);
+        if ((p = strstr(map, "tileheight=\""))) sscanf(p, "tileheight=\"%d\"", &tileH);
+    }
+    free(xml);
+    if (cols <= 0 || rows <= 0 || tileW <= 0 || tileH <= 0) return false;
+    *width = cols * tileW;
+    *height = rows * tileH;
+    return true;
+}
+
 void AddCollisionGroup(const char* tmxPath, const char* name, Colisao* col,
                        int* count, int cap) {
     Rectangle rects[64];
@@ -91,7 +130,7 @@ void PhaseToLowerCopy(const char* src, char* dst, size_t dstSize) {
 
 int PhaseCollectButtonGroupNames(const char* tmxPath, char names[][PHASE_BUTTON_NAME_LEN], int maxNames) {
     if (maxNames <= 0) return 0;
-    char* xml = LoadFileText(tmxPath);
+    char* xml = PhaseLoadText(tmxPath);
     if (!xml) return 0;
 
     int count = 0;
@@ -128,177 +167,20 @@ int PhaseCollectButtonGroupNames(const char* tmxPath, char names[][PHASE_BUTTON_
         search = tagClose + 1;
     }
 
-    UnloadFileText(xml);
+    free(xml);
     return count;
 }
 
-bool PhaseAnyButtonPressedWithToken(const bool* states, char names[][PHASE_BUTTON_NAME_LEN],
-                                    int count, const char* tokenLower) {
-    if (!states || !tokenLower || !tokenLower[0]) return false;
-    for (int i = 0; i < count; ++i) {
-        if (states[i] && strstr(names[i], tokenLower)) return true;
-    }
-    return false;
-}
-
-int LoadFramesRange(Texture2D* arr, int max, const char* pattern,
-                    int startIdx, int endIdx) {
-    int count = 0; bool started = false;
-    for (int i = startIdx; i <= endIdx && count < max; ++i) {
-        char path[256]; snprintf(path, sizeof(path), pattern, i);
-        if (!FileExists(path)) { if (started) break; else continue; }
-        Texture2D tex = LoadTexture(path);
-        if (tex.id != 0) { arr[count++] = tex; started = true; }
-        else if (started) break;
-    }
-    return count;
-}
-
-static void ResetLakeAnim(LakeAnimFrames* s) {
-    s->timer = 0.0f;
-    s->frame = 0;
-}
-
-void LoadLakeSet_Agua(LakeAnimFrames* s) {
-    s->leftCount   = LoadFramesRange(s->left,   32, "assets/map/agua/esquerdo/pixil-frame-%d.png",  0, 15);
-    s->middleCount = LoadFramesRange(s->middle, 32, "assets/map/agua/meio/pixil-frame-%d.png",      0, 15);
-    s->rightCount  = LoadFramesRange(s->right,  32, "assets/map/agua/direito/pixil-frame-%d.png",   0, 15);
-    ResetLakeAnim(s);
-}
-
-void LoadLakeSet_Terra(LakeAnimFrames* s) {
-    s->leftCount   = LoadFramesRange(s->left,   32, "assets/map/terra/esquerdo/pixil-frame-%d.png", 0, 15);
-    s->middleCount = LoadFramesRange(s->middle, 32, "assets/map/terra/meio/pixil-frame-%d.png",     0, 15);
-    s->rightCount  = LoadFramesRange(s->right,  32, "assets/map/terra/direito/pixil-frame-%d.png",  0, 15);
-    ResetLakeAnim(s);
-}
-
-void LoadLakeSet_Fogo(LakeAnimFrames* s) {
-    s->leftCount   = LoadFramesRange(s->left,   32, "assets/map/fogo/esquerdo/Esquerda%d.png", 1, 32);
-    if (s->leftCount == 0)
-        s->leftCount   = LoadFramesRange(s->left,   32, "assets/map/fogo/esquerdo/pixil-frame-%d.png", 0, 31);
-
-    s->middleCount = LoadFramesRange(s->middle, 32, "assets/map/fogo/meio/Meio%d.png",     1, 32);
-    if (s->middleCount == 0)
-        s->middleCount = LoadFramesRange(s->middle, 32, "assets/map/fogo/meio/pixil-frame-%d.png",      0, 31);
-
-    s->rightCount  = LoadFramesRange(s->right,  32, "assets/map/fogo/direito/Direita%d.png", 1, 32);
-    if (s->rightCount == 0)
-        s->rightCount  = LoadFramesRange(s->right,  32, "assets/map/fogo/direito/pixil-frame-%d.png",   0, 31);
-
-    ResetLakeAnim(s);
-}
-
-void LoadLakeSet_Acido(LakeAnimFrames* s) {
-    s->leftCount   = LoadFramesRange(s->left,   32, "assets/map/acido/esquerdo/pixil-frame-%d.png",  0, 15);
-    s->middleCount = LoadFramesRange(s->middle, 32, "assets/map/acido/meio/pixil-frame-%d.png",      0, 15);
-    s->rightCount  = LoadFramesRange(s->right,  32, "assets/map/acido/direito/pixil-frame-%d.png",   0, 15);
-    ResetLakeAnim(s);
-}
-
-void PhaseUnloadLakeSet(LakeAnimFrames* s) {
-    if (!s) return;
-    for (int i = 0; i < s->leftCount;   ++i) UnloadTexture(s->left[i]);
-    for (int i = 0; i < s->middleCount; ++i) UnloadTexture(s->middle[i]);
-    for (int i = 0; i < s->rightCount;  ++i) UnloadTexture(s->right[i]);
-    s->leftCount = s->middleCount = s->rightCount = 0;
-    s->timer = 0.0f;
-    s->frame = 0;
-}
-
-void PhaseUpdateLakeAnimations(LakeAnimFrames** sets, int setCount, float dt, float frameRate) {
-    if (!sets || setCount <= 0 || frameRate <= 0.0f) return;
-    for (int s = 0; s < setCount; ++s) {
-        LakeAnimFrames* frames = sets[s];
-        if (!frames) continue;
-        frames->timer += dt;
-        if (frames->timer >= frameRate) {
-            frames->timer -= frameRate;
-            int maxFrames = frames->middleCount;
-            if (maxFrames == 0) maxFrames = frames->leftCount;
-            if (maxFrames == 0) maxFrames = frames->rightCount;
-            if (maxFrames > 0) {
-                frames->frame = (frames->frame + 1) % maxFrames;
-            }
-        }
-    }
-}
-
-const Texture2D* PhasePickLakeFrame(const LakeAnimFrames* frames, LakePart part) {
-    if (!frames) return NULL;
-    int idx = frames->frame;
-    const Texture2D* array = NULL;
-    int count = 0;
-    switch (part) {
-        case PART_LEFT:   array = frames->left;   count = frames->leftCount; break;
-        case PART_MIDDLE: array = frames->middle; count = frames->middleCount; break;
-        case PART_RIGHT:  array = frames->right;  count = frames->rightCount; break;
-    }
-    if (!array || count <= 0) return NULL;
-    if (idx < 0) idx = 0;
-    if (idx >= count) idx %= count;
-    return &array[idx];
-}
-
-bool PhasePlayerInsideOwnLake(const Player* pl, LakeType type,
-                              const LakeSegment* segs, int segCount) {
-    if (!pl || !segs || segCount <= 0) return false;
-    for (int i = 0; i < segCount; ++i) {
-        if (segs[i].type != type) continue;
-        if (CheckCollisionRecs(pl->rect, segs[i].rect)) return true;
-    }
-    return false;
-}
-
-Texture2D LoadTextureIfExists(const char* path) {
-    if (!FileExists(path)) return (Texture2D){0};
-    return LoadTexture(path);
-}
-
-void PhaseLoadButtonSprites(ButtonSpriteSet* set) {
-    if (!set) return;
-    set->blue  = LoadTextureIfExists("assets/map/buttons/pixil-layer-bluebutton.png");
-    set->red   = LoadTextureIfExists("assets/map/buttons/pixil-layer-redbutton.png");
-    set->white = LoadTextureIfExists("assets/map/buttons/pixil-layer-whitebutton.png");
-    set->brown = LoadTextureIfExists("assets/map/buttons/pixil-layer-brownbutton.png");
-}
-
-void PhaseUnloadButtonSprites(ButtonSpriteSet* set) {
-    if (!set) return;
-    if (set->blue.id != 0)  UnloadTexture(set->blue);
-    if (set->red.id != 0)   UnloadTexture(set->red);
-    if (set->white.id != 0) UnloadTexture(set->white);
-    if (set->brown.id != 0) UnloadTexture(set->brown);
-    set->blue = set->red = set->white = set->brown = (Texture2D){0};
-}
-
-const Texture2D* PhasePickButtonSprite(const ButtonSpriteSet* set, const char* nameLower) {
-    if (!set) return NULL;
-    const Texture2D* match = NULL;
-    if (nameLower) {
-        if (strstr(nameLower, "branc") && set->white.id != 0) match = &set->white;
-        else if (strstr(nameLower, "azul") && set->blue.id != 0) match = &set->blue;
-        else if (strstr(nameLower, "verm") && set->red.id != 0) match = &set->red;
-        else if ((strstr(nameLower, "marr") || strstr(nameLower, "terra")) && set->brown.id != 0) match = &set->brown;
-    }
-    if (match) return match;
-
-    if (set->blue.id != 0)  return &set->blue;
-    if (set->red.id != 0)   return &set->red;
-    if (set->white.id != 0) return &set->white;
-    if (set->brown.id != 0) return &set->brown;
-    return NULL;
-}
-
-float PhaseMoveTowards(float a, float b, float maxStep) {
+float PhaseMoveTowards(float from, float to, float maxStep) {
+    SimNum a = SimNum_FromFloat(from), b = SimNum_FromFloat(to), step = SimNum_FromFloat(maxStep);
     if (a < b) {
-        a += maxStep;
+        a += step;
         if (a > b) a = b;
     } else if (a > b) {
-        a -= maxStep;
+        a -= step;
         if (a < b) a = b;
     }
-    return a;
+    return SimNum_ToFloat(a);
 }
 
 static void PhaseClampPlatform(PhasePlatform* platform) {
@@ -343,7 +225,7 @@ float PhasePlatformMoveTowards(PhasePlatform* platform, float targetY) {
 
 void PhaseHandlePlatformTop(Player* pl, Rectangle plat, float deltaY) {
     if (!pl || plat.width <= 0 || plat.height <= 0) return;
-    if (!CheckCollisionRecs(pl->rect, plat)) return;
+    if (!SimRectsOverlap(pl->rect, plat)) return;
     float pBottom = pl->rect.y + pl->rect.height;
     if (pBottom <= plat.y + 16.0f && pl->velocity.y >= -1.0f) {
         pl->rect.y = plat.y - pl->rect.height;
@@ -374,51 +256,229 @@ Rectangle PhaseAcquireSpriteForRect(Rectangle target, Rectangle* sprites, bool*
     return target;
 }
 
-bool PhaseCheckDoor(const Rectangle* door, const Player* p) {
-    if (!door || !p) return false;
-    if (door->width <= 0 || door->height <= 0) return false;
-    return CheckCollisionRecs(*door, p->rect);
-}
-
-static void PhaseResolvePlayerVsRect(Player* pl, Rectangle bloco, float stepHeight) {
-    if (!pl) return;
-    if (!CheckCollisionRecs(pl->rect, bloco)) return;
+// O que a resolução contra um bloco fez com o jogador
+typedef enum PhaseContact {
+    PHASE_CONTACT_NONE = 0,
+    PHASE_CONTACT_STEP,     // subiu o degrau
+    PHASE_CONTACT_WALL,
+    PHASE_CONTACT_CEILING,
+    PHASE_CONTACT_GROUND
+} PhaseContact;
+
+static PhaseContact PhaseResolvePlayerVsRect(Player* pl, Rectangle bloco, float stepHeight) {
+    if (!pl) return PHASE_CONTACT_NONE;
+    if (!SimRectsOverlap(pl->rect, bloco)) return PHASE_CONTACT_NONE;
     float dx = (pl->rect.x + pl->rect.width * 0.5f) - (bloco.x + bloco.width * 0.5f);
     float dy = (pl->rect.y + pl->rect.height * 0.5f) - (bloco.y + bloco.height * 0.5f);
     float overlapX = (pl->rect.width * 0.5f + bloco.width * 0.5f) - fabsf(dx);
     float overlapY = (pl->rect.height * 0.5f + bloco.height * 0.5f) - fabsf(dy);
-    if (overlapX <= 0 || overlapY <= 0) return;
+    if (overlapX <= 0 || overlapY <= 0) return PHASE_CONTACT_NONE;
 
     if (overlapX < overlapY) {
         Rectangle teste = pl->rect;
         teste.y -= stepHeight;
-        if (!(dy > 0 && pl->velocity.y > 0) && !CheckCollisionRecs(teste, bloco)) {
+        if (!(dy > 0 && pl->velocity.y > 0) && !SimRectsOverlap(teste, bloco)) {
             pl->rect.y -= stepHeight;
-            return;
+            return PHASE_CONTACT_STEP;
         }
         if (dx > 0) pl->rect.x += overlapX;
         else        pl->rect.x -= overlapX;
         pl->velocity.x = 0;
-    } else {
-        if (dy > 0 && pl->velocity.y < 0) {
-            pl->rect.y += overlapY;
-            pl->velocity.y = 0;
-        } else if (dy < 0 && pl->velocity.y >= 0) {
-            pl->rect.y -= overlapY;
-            pl->velocity.y = 0;
-            pl->isJumping = false;
+        return PHASE_CONTACT_WALL;
+    }
+    if (dy > 0 && pl->velocity.y < 0) {
+        pl->rect.y += overlapY;
+        pl->velocity.y = 0;
+        return PHASE_CONTACT_CEILING;
+    }
+    if (dy < 0 && pl->velocity.y >= 0) {
+        pl->rect.y -= overlapY;
+        pl->velocity.y = 0;
+        pl->isJumping = false;
+        return PHASE_CONTACT_GROUND;
+    }
+    return PHASE_CONTACT_NONE;
+}
+
+static bool PhaseSameRect(Rectangle a, Rectangle b) {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+// Resolve contra todos os próximos, anotando quem empurrou o jogador
+static void PhaseResolveAgainstNear(Player* pl, const CollisionGrid* grid, const int* near, int n,
+                                    float stepHeight, PlayerContacts* c) {
+    for (int i = 0; i < n; ++i) {
+        Rectangle bloco = grid->rects[near[i]].rect;
+        PhaseContact kind = PhaseResolvePlayerVsRect(pl, bloco, stepHeight);
+        if (kind == PHASE_CONTACT_NONE) continue;
+        if (kind == PHASE_CONTACT_GROUND) c->ground = near[i];
+        if (c->count < PLAYER_MAX_CONTACTS) {
+            c->index[c->count] = near[i];
+            c->rect[c->count] = bloco;
+            c->count++;
+        } else {
+            c->valid = false; // contatos demais para lembrar: não reaproveita
+        }
+    }
+}
+
+// O tick de agora é igual ao último resolvido (mesmo começo, mesmo movimento) e
+// o jogador terminou aquele tick parado no chão, no mesmo lugar em que começou
+static bool PhaseContactsReusable(const Player* pl, const CollisionGrid* grid) {
+    const PlayerContacts* c = &pl->contacts;
+    if (!c->valid || c->grid != grid || c->ground < 0 || c->restJumping) return false;
+    if (!PhaseSameRect(c->rest, c->from) || !PhaseSameRect(pl->prevRect, c->from)) return false;
+    if (!PhaseSameRect(pl->rect, c->enter) || pl->isJumping != c->enterJumping ||
+        pl->velocity.x != c->enterVelocity.x || pl->velocity.y != c->enterVelocity.y) return false;
+    // Apoio e paredes primeiro: se algum saiu do lugar, resolve de novo
+    for (int i = 0; i < c->count; ++i) {
+        if (c->index[i] >= grid->count || !PhaseSameRect(grid->rects[c->index[i]].rect, c->rect[i])) return false;
+    }
+    // Estáticos não mudam; um dinâmico que se mexeu só importa se estava ou está por perto
+    if (c->dynamicEpoch != grid->dynamicEpoch) {
+        if (c->nearDynamic) return false;
+        if (grid->dynamicCount > 0 && SimRectsOverlap(c->area, grid->dynamicBounds)) return false;
+    }
+    return true;
+}
+
+Rectangle PhaseResolveReach(Rectangle rect, float extra) {
+    return (Rectangle){ rect.x - rect.width - extra, rect.y - rect.height - extra,
+                        rect.width * 3.0f + extra * 2.0f, rect.height * 3.0f + extra * 2.0f };
+}
+
+float PhaseSweepRect(Rectangle moving, Vector2 delta, Rectangle target) {
+    // Raio do canto de moving contra target inflado pelo tamanho de moving
+    float from[2] = { moving.x, moving.y };
+    float d[2] = { delta.x, delta.y };
+    float lo[2] = { target.x - moving.width, target.y - moving.height };
+    float hi[2] = { target.x + target.width, target.y + target.height };
+    float tEnter = -FLT_MAX, tExit = FLT_MAX;
+    for (int a = 0; a < 2; ++a) {
+        if (d[a] == 0.0f) {
+            if (from[a] <= lo[a] || from[a] >= hi[a]) return 1.0f;
+            continue;
         }
+        float t0 = (lo[a] - from[a]) / d[a];
+        float t1 = (hi[a] - from[a]) / d[a];
+        if (t0 > t1) { float t = t0; t0 = t1; t1 = t; }
+        if (t0 > tEnter) tEnter = t0;
+        if (t1 < tExit) tExit = t1;
+    }
+    if (tEnter < 0.0f || tEnter >= tExit || tEnter >= 1.0f) return 1.0f;
+    return tEnter;
+}
+
+static Rectangle PhaseSweptBounds(Rectangle a, Rectangle b) {
+    float x0 = fminf(a.x, b.x), y0 = fminf(a.y, b.y);
+    float x1 = fmaxf(a.x + a.width, b.x + b.width), y1 = fmaxf(a.y + a.height, b.y + b.height);
+    return (Rectangle){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Menor tempo de impacto entre as colisões próximas, ou 1 se o deslocamento é curto
+// demais para atravessar alguma delas. safeStep recebe o maior passo que a resolução
+// por sobreposição aguenta (metade da colisão mais fina, incluindo quem se move).
+static float PhaseSweepNear(const CollisionGrid* grid, const int* near, int n,
+                            Rectangle from, Vector2 delta, float* safeStep) {
+    float thinnest = fminf(from.width, from.height);
+    for (int i = 0; i < n; ++i) {
+        Rectangle r = grid->rects[near[i]].rect;
+        thinnest = fminf(thinnest, fminf(r.width, r.height));
+    }
+    if (safeStep) *safeStep = fmaxf(thinnest * 0.5f, 1.0f);
+    float travel = fmaxf(fabsf(delta.x), fabsf(delta.y));
+    if (travel <= thinnest * 0.5f) return 1.0f;
+
+    float toi = 1.0f;
+    for (int i = 0; i < n; ++i) {
+        float t = PhaseSweepRect(from, delta, grid->rects[near[i]].rect);
+        if (t < toi) toi = t;
+    }
+    return toi;
+}
+
+bool PhaseSweepClamp(CollisionGrid* grid, Rectangle* rect, Rectangle from) {
+    if (!grid || !rect) return false;
+    Vector2 delta = { rect->x - from.x, rect->y - from.y };
+    int near[COLLISION_GRID_QUERY_MAX];
+    int n = CollisionGrid_Query(grid, PhaseSweptBounds(from, *rect), near, COLLISION_GRID_QUERY_MAX);
+    float toi = PhaseSweepNear(grid, near, n, from, delta, NULL);
+    if (toi >= 1.0f) return false;
+    rect->x = SimQuantize(from.x + delta.x * toi);
+    rect->y = SimQuantize(from.y + delta.y * toi);
+    return true;
+}
+
+// Refaz o movimento do tick em passos menores; um eixo bloqueado para de avançar.
+// No modo fixo o passo é dividido em inteiros e continua na grade
+static void PhaseResolveInSteps(Player* pl, const CollisionGrid* grid, const int* near, int n,
+                                Rectangle from, Vector2 delta, int steps, float stepHeight,
+                                PlayerContacts* c) {
+    Vector2 step = { SimNum_ToFloat(SimNum_FromFloat(delta.x) / steps),
+                     SimNum_ToFloat(SimNum_FromFloat(delta.y) / steps) };
+    pl->rect.x = from.x;
+    pl->rect.y = from.y;
+    for (int s = 0; s < steps; ++s) {
+        float wantX = pl->rect.x + step.x;
+        float velY = pl->velocity.y;
+        pl->rect.x = wantX;
+        pl->rect.y += step.y;
+        PhaseResolveAgainstNear(pl, grid, near, n, stepHeight, c);
+        if (pl->rect.x != wantX) step.x = 0.0f;
+        if (velY != 0.0f && pl->velocity.y == 0.0f) step.y = 0.0f;
     }
 }
 
 void PhaseResolvePlayersVsWorld(Player** players, int playerCount,
-                                const Colisao* colisoes, int totalColisoes, float stepHeight) {
-    if (!players || !colisoes || playerCount <= 0 || totalColisoes <= 0) return;
+                                CollisionGrid* grid, float stepHeight) {
+    if (!players || !grid || playerCount <= 0) return;
+    int near[COLLISION_GRID_QUERY_MAX];
     for (int p = 0; p < playerCount; ++p) {
         Player* pl = players[p];
         if (!pl) continue;
-        for (int i = 0; i < totalColisoes; ++i) {
-            PhaseResolvePlayerVsRect(pl, colisoes[i].rect, stepHeight);
+        PlayerContacts* c = &pl->contacts;
+
+        // Parado no chão sem nada mudando em volta: o resultado é o do tick anterior
+        if (PhaseContactsReusable(pl, grid)) {
+            pl->rect = c->rest;
+            pl->velocity = c->restVelocity;
+            pl->isJumping = c->restJumping;
+            continue;
         }
+
+        Rectangle from = pl->prevRect;
+        Vector2 delta = { pl->rect.x - from.x, pl->rect.y - from.y };
+        Rectangle area = PhaseResolveReach(PhaseSweptBounds(from, pl->rect), stepHeight);
+        int n = CollisionGrid_Query(grid, area, near, COLLISION_GRID_QUERY_MAX);
+
+        c->valid = true;
+        c->grid = grid;
+        c->dynamicEpoch = grid->dynamicEpoch;
+        c->nearDynamic = grid->dynamicCount > 0 && SimRectsOverlap(area, grid->dynamicBounds);
+        c->area = area;
+        c->from = from;
+        c->enter = pl->rect;
+        c->enterVelocity = pl->velocity;
+        c->enterJumping = pl->isJumping;
+        c->ground = -1;
+        c->count = 0;
+
+        int steps = 1;
+        float safeStep;
+        if (PhaseSweepNear(grid, near, n, from, delta, &safeStep) < 1.0f) {
+            float travel = fmaxf(fabsf(delta.x), fabsf(delta.y));
+            steps = (int)ceilf(travel / safeStep);
+            if (steps > PHASE_SWEEP_MAX_STEPS) steps = PHASE_SWEEP_MAX_STEPS;
+            if (steps < 1) steps = 1;
+        }
+
+        if (steps == 1) {
+            PhaseResolveAgainstNear(pl, grid, near, n, stepHeight, c);
+        } else {
+            PhaseResolveInSteps(pl, grid, near, n, from, delta, steps, stepHeight, c);
+        }
+        c->rest = pl->rect;
+        c->restVelocity = pl->velocity;
+        c->restJumping = pl->isJumping;
     }
-}
+}
\ No newline at end of file
@@ -3,7 +3,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
-#include "raylib.h"
+#include "../../game/sim_types.h"
 #include "../../player/player.h"
 #include "../../objects/lake.h"
 
@@ -13,6 +13,9 @@
 #endif
 #define PHASE_STEP_HEIGHT     14.0f
 
+// Índice de cada jogador nos vetores players[] das fases (e no input do runtime)
+enum { PHASE_EARTH = 0, PHASE_FIRE = 1, PHASE_WATER = 2 };
+
 typedef struct PhaseCollision {
     Rectangle rect;
 } Colisao;
@@ -29,13 +32,6 @@ typedef struct PhaseLakeSegment {
     LakePart part;
 } LakeSegment;
 
-typedef struct PhaseLakeAnimFrames {
-    Texture2D left[32];   int leftCount;
-    Texture2D middle[32]; int middleCount;
-    Texture2D right[32];  int rightCount;
-    float timer; int frame;
-} LakeAnimFrames;
-
 typedef struct PhaseButtonSpriteSet {
     Texture2D blue;
     Texture2D red;
@@ -54,24 +50,14 @@ typedef PhasePlatform Platform;
 
 int ParseRectsFromGroup(const char* tmxPath, const char* groupName, Rectangle* out, int cap);
 int ParseRectsFromAny(const char* tmxPath, const char** names, int nNames, Rectangle* out, int cap);
+// Largura/altura do mapa em px (width*tilewidth, height*tileheight da tag <map>)
+bool PhaseMapSize(const char* tmxPath, int* width, int* height);
 void AddCollisionGroup(const char* tmxPath, const char* name, Colisao* col, int* count, int cap);
 void AddLakeSegments(const char* tmxPath, const char* name, LakeType type, LakePart part,
                      LakeSegment* segs, int* count, int cap);
 
 void PhaseToLowerCopy(const char* src, char* dst, size_t dstSize);
 int PhaseCollectButtonGroupNames(const char* tmxPath, char names[][PHASE_BUTTON_NAME_LEN], int maxNames);
-bool PhaseAnyButtonPressedWithToken(const bool* states, char names[][PHASE_BUTTON_NAME_LEN],
-                                    int count, const char* tokenLower);
-
-int LoadFramesRange(Texture2D* arr, int max, const char* pattern, int startIdx, int endIdx);
-void LoadLakeSet_Agua(LakeAnimFrames* frames);
-void LoadLakeSet_Terra(LakeAnimFrames* frames);
-void LoadLakeSet_Fogo(LakeAnimFrames* frames);
-void LoadLakeSet_Acido(LakeAnimFrames* frames);
-void PhaseUnloadLakeSet(LakeAnimFrames* frames);
-void PhaseUpdateLakeAnimations(LakeAnimFrames** sets, int setCount, float dt, float frameRate);
-const Texture2D* PhasePickLakeFrame(const LakeAnimFrames* frames, LakePart part);
-bool PhasePlayerInsideOwnLake(const Player* pl, LakeType type, const LakeSegment* segs, int segCount);
 
 Texture2D LoadTextureIfExists(const char* path);
 void PhaseLoadButtonSprites(ButtonSpriteSet* set);
@@ -85,8 +71,23 @@ float PhasePlatformMoveTowards(PhasePlatform* platform, float targetY);
 void PhaseHandlePlatformTop(Player* pl, Rectangle platformRect, float deltaY);
 
 Rectangle PhaseAcquireSpriteForRect(Rectangle target, Rectangle* sprites, bool* used, int spriteCount);
-bool PhaseCheckDoor(const Rectangle* door, const Player* p);
+// Resolve cada jogador só contra as colisões próximas, consultadas na grade da fase.
+// Se o tick moveu o jogador (prevRect -> rect) mais que metade da colisão mais fina
+// no caminho e a varredura acusa contato, o movimento é refeito em subpassos.
+struct CollisionGrid;
 void PhaseResolvePlayersVsWorld(Player** players, int playerCount,
-                                const Colisao* colisoes, int totalColisoes, float stepHeight);
+                                struct CollisionGrid* grid, float stepHeight);
+// Área em volta de rect que a resolução pode alcançar (um empurrão nunca passa do próprio tamanho)
+Rectangle PhaseResolveReach(Rectangle rect, float extra);
+
+#define PHASE_SWEEP_MAX_STEPS 16   // subpassos por tick num movimento rápido
+
+// Tempo de impacto (0..1) de moving deslocado por delta contra target; 1 = não encosta.
+// Quem já começa sobreposto também dá 1 (isso é trabalho da resolução por sobreposição).
+float PhaseSweepRect(Rectangle moving, Vector2 delta, Rectangle target);
+// Recua rect até o primeiro contato no caminho desde from, se o deslocamento for maior que
+// metade da colisão mais fina por perto (abaixo disso a resolução normal não deixa atravessar).
+// Devolve true se recuou.
+bool PhaseSweepClamp(struct CollisionGrid* grid, Rectangle* rect, Rectangle from);
 
 #endif
@@ -0,0 +1,257 @@
+#include "phase_runtime.h"
+#include "../../structure/spsc_ring.h"
+#include "../../game/sim_clock.h"
+#include "../../game/sim_input.h"
+#include "../../interface/pause.h"
+#include "../../interface/text_cache.h"
+#include "../../audio/theme.h"
+#include "../../render/render_scale.h"
+#include "../../render/particles.h"
+#include "../../render/frame_capture.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Três listas: uma sendo desenhada, uma sendo gravada e uma de folga.
+// O input do frame N+1 só é enviado depois que a lista N-1 foi desenhada,
+// então nunca há mais de duas listas em trânsito.
+#define PHASE_LIST_COUNT  3
+#define PHASE_INPUT_SLOTS SPSC_RING_CAPACITY
+
+typedef struct {
+    const PhaseRuntimeDesc* desc;
+    PhaseInput inputs[PHASE_INPUT_SLOTS];
+    PhaseCmdList* lists;
+    SpscRing inputRing;   // janela -> simulação (índice do input)
+    SpscRing listRing;    // simulação -> janela (índice da lista)
+    unsigned simFrame;
+} PhaseRuntime;
+
+// --- Gravação de comandos ---
+
+static PhaseCmd* PushCmd(PhaseCmdList* list, PhaseCmdType type) {
+    if (list->count >= PHASE_CMD_MAX) return NULL;
+    PhaseCmd* c = &list->cmds[list->count++];
+    c->type = type;
+    return c;
+}
+
+void PhaseCmd_Begin(PhaseCmdList* list, Camera2D camera) {
+    list->count = 0;
+    list->playerCount = 0;
+    list->worldCount = -1;
+    list->camera = camera;
+    list->finished = false;
+}
+
+void PhaseCmd_BeginHud(PhaseCmdList* list) {
+    list->worldCount = list->count;
+}
+
+void PhaseCmd_Background(PhaseCmdList* list) {
+    PushCmd(list, PHASE_CMD_BACKGROUND);
+}
+
+void PhaseCmd_Texture(PhaseCmdList* list, Texture2D tex, Rectangle src, Rectangle dst, Color tint) {
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_TEXTURE);
+    if (!c) return;
+    c->as.texture.tex = tex; c->as.texture.src = src; c->as.texture.dst = dst; c->as.texture.tint = tint;
+}
+
+void PhaseCmd_Rect(PhaseCmdList* list, Rectangle rect, Color color) {
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_RECT);
+    if (!c) return;
+    c->as.rect.rect = rect; c->as.rect.thick = 0.0f; c->as.rect.color = color;
+}
+
+void PhaseCmd_RectLines(PhaseCmdList* list, Rectangle rect, float thick, Color color) {
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_RECT_LINES);
+    if (!c) return;
+    c->as.rect.rect = rect; c->as.rect.thick = thick; c->as.rect.color = color;
+}
+
+void PhaseCmd_Player(PhaseCmdList* list, const Player* p) {
+    if (list->playerCount >= PHASE_CMD_PLAYERS) return;
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_PLAYER);
+    if (!c) return;
+    list->players[list->playerCount] = *p;
+    c->as.player = list->playerCount++;
+}
+
+void PhaseCmd_Lakes(PhaseCmdList* list, float time) {
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_LAKES);
+    if (c) c->as.lakeTime = time;
+}
+
+void PhaseCmd_Particles(PhaseCmdList* list) {
+    PushCmd(list, PHASE_CMD_PARTICLES);
+}
+
+void PhaseCmd_DeathBurst(PhaseCmdList* list, Rectangle at, LakeType lake) {
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_DEATH_BURST);
+    if (!c) return;
+    c->as.burst.at = at; c->as.burst.lake = lake;
+}
+
+void PhaseCmd_Text(PhaseCmdList* list, const char* text, int x, int y, int size, Color color) {
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_TEXT);
+    if (!c) return;
+    strncpy(c->as.text.text, text, PHASE_CMD_TEXT_LEN - 1);
+    c->as.text.text[PHASE_CMD_TEXT_LEN - 1] = '\0';
+    c->as.text.x = x; c->as.text.y = y; c->as.text.size = size; c->as.text.color = color;
+}
+
+void PhaseCmd_Clock(PhaseCmdList* list, float seconds, bool minutes, int x, int y, int size, Color color) {
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_CLOCK);
+    if (!c) return;
+    c->as.clock.seconds = seconds; c->as.clock.minutes = minutes;
+    c->as.clock.x = x; c->as.clock.y = y; c->as.clock.size = size; c->as.clock.color = color;
+}
+
+void PhaseCmd_Fps(PhaseCmdList* list, int x, int y) {
+    PhaseCmd* c = PushCmd(list, PHASE_CMD_FPS);
+    if (!c) return;
+    c->as.fps.x = x; c->as.fps.y = y;
+}
+
+// --- Execução (thread da janela) ---
+
+static void ExecuteCmd(const PhaseRuntimeDesc* desc, const PhaseCmdList* list, const PhaseCmd* c) {
+    switch (c->type) {
+        case PHASE_CMD_TEXTURE:
+            DrawTexturePro(c->as.texture.tex, c->as.texture.src, c->as.texture.dst, (Vector2){0, 0}, 0.0f, c->as.texture.tint);
+            break;
+        case PHASE_CMD_BACKGROUND: if (desc->background) PhaseBackgroundDraw(desc->background, list->camera); break;
+        case PHASE_CMD_RECT:       DrawRectangleRec(c->as.rect.rect, c->as.rect.color); break;
+        case PHASE_CMD_RECT_LINES: DrawRectangleLinesEx(c->as.rect.rect, c->as.rect.thick, c->as.rect.color); break;
+        case PHASE_CMD_PLAYER:     DrawPlayer(list->players[c->as.player]); break;
+        case PHASE_CMD_LAKES:      if (desc->lakes) LakeRendererDraw(desc->lakes, c->as.lakeTime); break;
+        case PHASE_CMD_PARTICLES:  Particles_Draw(); break;
+        case PHASE_CMD_DEATH_BURST: Particles_BurstDeath(c->as.burst.at, c->as.burst.lake); break;
+        case PHASE_CMD_TEXT:
+            TextCache_Draw(c->as.text.text, c->as.text.x, c->as.text.y, c->as.text.size, c->as.text.color);
+            break;
+        case PHASE_CMD_CLOCK:
+            TextCache_DrawClock(c->as.clock.seconds, c->as.clock.minutes, c->as.clock.x, c->as.clock.y, c->as.clock.size, c->as.clock.color);
+            break;
+        case PHASE_CMD_FPS:        DrawFPS(c->as.fps.x, c->as.fps.y); break;
+    }
+}
+
+static void ExecuteList(const PhaseRuntimeDesc* desc, const PhaseCmdList* list) {
+    int world = list->worldCount < 0 ? list->count : list->worldCount;
+    BeginDrawing();
+    ClearBackground(BLACK);
+    RenderScale_BeginWorld();
+    BeginMode2D(RenderScale_WorldCamera(list->camera));
+    for (int i = 0; i < world; ++i) ExecuteCmd(desc, list, &list->cmds[i]);
+    EndMode2D();
+    RenderScale_EndWorld();
+    for (int i = world; i < list->count; ++i) ExecuteCmd(desc, list, &list->cmds[i]);
+    Pause_FrameEnd();
+    FrameCapture_Frame();
+    EndDrawing();
+}
+
+// --- Simulação ---
+
+static int SimulateOne(PhaseRuntime* rt, int inputSlot) {
+    int li = (int)(rt->simFrame++ % PHASE_LIST_COUNT);
+    rt->desc->step(rt->desc->state, &rt->inputs[inputSlot], &rt->lists[li]);
+    return li;
+}
+
+static void* SimThread(void* arg) {
+    PhaseRuntime* rt = (PhaseRuntime*)arg;
+    for (;;) {
+        int slot = SpscRing_Pop(&rt->inputRing);
+        if (rt->inputs[slot].quit) break;
+        int li = SimulateOne(rt, slot);
+        SpscRing_Push(&rt->listRing, li);
+    }
+    return NULL;
+}
+
+static void ReadInput(PhaseInput* in, SimClock* clock) {
+    memset(in, 0, sizeof(*in));
+    in->frameDt = GetFrameTime();
+    in->ticks = SimClock_Advance(clock, in->frameDt);
+    // Sem tick neste frame o toque de pulo fica travado para o próximo
+    bool ticking = in->ticks > 0;
+    in->players[PHASE_EARTH] = (PlayerInput){ IsKeyDown(KEY_J), IsKeyDown(KEY_L), ticking && SimInput_Pressed(KEY_I) };
+    in->players[PHASE_FIRE]  = (PlayerInput){ IsKeyDown(KEY_LEFT), IsKeyDown(KEY_RIGHT), ticking && SimInput_Pressed(KEY_UP) };
+    in->players[PHASE_WATER] = (PlayerInput){ IsKeyDown(KEY_A), IsKeyDown(KEY_D), ticking && SimInput_Pressed(KEY_W) };
+    in->toggleDebug = IsKeyPressed(KEY_TAB);
+}
+
+PhaseRunResult PhaseRuntime_Run(const PhaseRuntimeDesc* desc) {
+    PhaseRuntime rt;
+    memset(&rt, 0, sizeof(rt));
+    rt.desc = desc;
+    rt.lists = (PhaseCmdList*)calloc(PHASE_LIST_COUNT, sizeof(PhaseCmdList));
+    if (!rt.lists) return PHASE_RUN_TO_MAP;
+
+    bool threaded = false;
+    pthread_t thread;
+    if (SpscRing_Init(&rt.inputRing)) {
+        if (SpscRing_Init(&rt.listRing)) {
+            threaded = pthread_create(&thread, NULL, SimThread, &rt) == 0;
+            if (!threaded) SpscRing_Destroy(&rt.listRing);
+        }
+        if (!threaded) SpscRing_Destroy(&rt.inputRing);
+    }
+
+    SimClock clock;
+    SimClock_Start(&clock);
+    PhaseRunResult result = PHASE_RUN_WINDOW_CLOSED;
+    unsigned inputFrame = 0;
+    int pending = -1; // lista pronta ainda não desenhada (modo sem thread)
+
+    // Primeiro frame: a simulação começa antes do primeiro desenho
+    int slot = (int)(inputFrame++ % PHASE_INPUT_SLOTS);
+    ReadInput(&rt.inputs[slot], &clock);
+    if (threaded) SpscRing_Push(&rt.inputRing, slot);
+    else pending = SimulateOne(&rt, slot);
+
+    while (!WindowShouldClose()) {
+        Theme_Update();
+        RenderScale_Update();
+        FrameCapture_Update();
+
+        // Envia o input do próximo frame antes de desenhar o atual: os dois correm juntos
+        slot = (int)(inputFrame++ % PHASE_INPUT_SLOTS);
+        ReadInput(&rt.inputs[slot], &clock);
+        int li;
+        if (threaded) {
+            SpscRing_Push(&rt.inputRing, slot);
+            li = SpscRing_Pop(&rt.listRing);
+        } else {
+            li = pending;
+        }
+
+        Particles_Update(GetFrameTime());
+        ExecuteList(desc, &rt.lists[li]);
+        if (rt.lists[li].finished) { result = PHASE_RUN_COMPLETED; break; }
+
+        if (Pause_Pending()) {
+            // A simulação para sozinha: sem input novo ela só termina o frame em curso
+            PauseResult pr = ShowPauseMenu();
+            if (pr == PAUSE_TO_MAP) { result = PHASE_RUN_TO_MAP; break; }
+            if (pr == PAUSE_TO_MENU) { result = PHASE_RUN_TO_MENU; break; }
+        }
+
+        if (!threaded) pending = SimulateOne(&rt, slot);
+    }
+
+    if (threaded) {
+        slot = (int)(inputFrame++ % PHASE_INPUT_SLOTS);
+        memset(&rt.inputs[slot], 0, sizeof(rt.inputs[slot]));
+        rt.inputs[slot].quit = true;
+        SpscRing_Push(&rt.inputRing, slot);
+        pthread_join(thread, NULL);
+        SpscRing_Destroy(&rt.inputRing);
+        SpscRing_Destroy(&rt.listRing);
+    }
+    free(rt.lists);
+    return result;
+}
@@ -0,0 +1,103 @@
+// Execução de uma fase em duas threads: a simulação roda numa thread própria e
+// descreve cada frame numa lista imutável de comandos de desenho; a thread da
+// janela (dona do OpenGL e do teclado) lê o input, consome as listas por uma
+// fila SPSC e desenha. A simulação do frame N+1 corre junto com o desenho do N.
+#ifndef PHASE_RUNTIME_H
+#define PHASE_RUNTIME_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "../../player/player.h"
+#include "../../objects/lake.h"
+#include "lake_renderer.h"
+#include "tilemap_renderer.h"
+
+#define PHASE_CMD_MAX      2048
+#define PHASE_CMD_PLAYERS  4      // cópias de Player por frame (são grandes demais para cada comando)
+#define PHASE_CMD_TEXT_LEN 64
+
+typedef struct {
+    PlayerInput players[3];
+    bool toggleDebug;
+    int ticks;           // ticks de física a simular neste frame (SimClock)
+    float frameDt;       // tempo real do frame, só para animações visuais
+    bool quit;           // pede para a thread de simulação terminar
+} PhaseInput;
+
+typedef enum {
+    PHASE_CMD_TEXTURE = 0,
+    PHASE_CMD_BACKGROUND,
+    PHASE_CMD_RECT,
+    PHASE_CMD_RECT_LINES,
+    PHASE_CMD_PLAYER,
+    PHASE_CMD_LAKES,
+    PHASE_CMD_PARTICLES,
+    PHASE_CMD_DEATH_BURST,
+    PHASE_CMD_TEXT,
+    PHASE_CMD_CLOCK,
+    PHASE_CMD_FPS
+} PhaseCmdType;
+
+typedef struct {
+    PhaseCmdType type;
+    union {
+        struct { Texture2D tex; Rectangle src, dst; Color tint; } texture;
+        struct { Rectangle rect; float thick; Color color; } rect;
+        int player;      // índice em PhaseCmdList.players
+        float lakeTime;
+        struct { Rectangle at; LakeType lake; } burst;
+        struct { char text[PHASE_CMD_TEXT_LEN]; int x, y, size; Color color; } text;
+        struct { float seconds; bool minutes; int x, y, size; Color color; } clock;
+        struct { int x, y; } fps;
+    } as;
+} PhaseCmd;
+
+// Um frame completo: comandos do mundo (câmera) seguidos dos do HUD (tela)
+typedef struct {
+    PhaseCmd cmds[PHASE_CMD_MAX];
+    int count;
+    Player players[PHASE_CMD_PLAYERS];
+    int playerCount;
+    int worldCount;      // cmds[0..worldCount) usam a câmera
+    Camera2D camera;
+    bool finished;       // a simulação terminou a fase neste frame
+} PhaseCmdList;
+
+// Gravação (thread de simulação)
+void PhaseCmd_Begin(PhaseCmdList* list, Camera2D camera);
+void PhaseCmd_BeginHud(PhaseCmdList* list);
+void PhaseCmd_Background(PhaseCmdList* list);
+void PhaseCmd_Texture(PhaseCmdList* list, Texture2D tex, Rectangle src, Rectangle dst, Color tint);
+void PhaseCmd_Rect(PhaseCmdList* list, Rectangle rect, Color color);
+void PhaseCmd_RectLines(PhaseCmdList* list, Rectangle rect, float thick, Color color);
+void PhaseCmd_Player(PhaseCmdList* list, const Player* p);
+void PhaseCmd_Lakes(PhaseCmdList* list, float time);
+void PhaseCmd_Particles(PhaseCmdList* list);
+void PhaseCmd_DeathBurst(PhaseCmdList* list, Rectangle at, LakeType lake);
+void PhaseCmd_Text(PhaseCmdList* list, const char* text, int x, int y, int size, Color color);
+void PhaseCmd_Clock(PhaseCmdList* list, float seconds, bool minutes, int x, int y, int size, Color color);
+void PhaseCmd_Fps(PhaseCmdList* list, int x, int y);
+
+// Passo da simulação: consome o input do frame e grava o que deve ser desenhado.
+// Roda fora da thread da janela: não pode chamar nada da raylib que use GL ou input.
+typedef void (*PhaseSimStepFn)(void* state, const PhaseInput* input, PhaseCmdList* out);
+
+typedef struct {
+    void* state;
+    PhaseSimStepFn step;
+    const LakeRenderer* lakes;   // desenhado pela thread da janela (PHASE_CMD_LAKES)
+    const PhaseBackground* background; // PHASE_CMD_BACKGROUND
+} PhaseRuntimeDesc;
+
+typedef enum {
+    PHASE_RUN_COMPLETED = 0,
+    PHASE_RUN_TO_MAP,
+    PHASE_RUN_TO_MENU,
+    PHASE_RUN_WINDOW_CLOSED
+} PhaseRunResult;
+
+// Roda até a simulação marcar finished, o jogador sair pelo pause ou a janela fechar.
+// Se a thread não puder ser criada, simula na própria thread da janela.
+PhaseRunResult PhaseRuntime_Run(const PhaseRuntimeDesc* desc);
+
+#endif
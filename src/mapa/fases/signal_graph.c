@@ -0,0 +1,83 @@
+#include "signal_graph.h"
+#include <string.h>
+
+void SignalGraph_Init(SignalGraph* g, int inputCount) {
+    memset(g, 0, sizeof(*g));
+    if (inputCount < 0) inputCount = 0;
+    if (inputCount > SIGNAL_MAX_INPUTS) inputCount = SIGNAL_MAX_INPUTS;
+    g->inputCount = inputCount;
+}
+
+int SignalGraph_AddOutput(SignalGraph* g, SignalMode mode) {
+    if (g->outputCount >= SIGNAL_MAX_OUTPUTS) return -1;
+    int id = g->outputCount++;
+    g->wires[id] = 0;
+    g->mode[id] = (unsigned char)mode;
+    g->outputs &= ~(1u << id);
+    return id;
+}
+
+void SignalGraph_Connect(SignalGraph* g, int output, int input) {
+    if (output < 0 || output >= g->outputCount || input < 0 || input >= g->inputCount) return;
+    g->wires[output] |= 1u << input;
+    g->fanout[input] |= 1u << output;
+}
+
+// Procura cada token da lista "a|b|c" dentro do nome
+static bool NameHasAnyToken(const char* name, const char* tokens) {
+    char token[64];
+    const char* p = tokens;
+    while (*p) {
+        size_t len = strcspn(p, "|");
+        if (len > 0 && len < sizeof(token)) {
+            memcpy(token, p, len);
+            token[len] = '\0';
+            if (strstr(name, token)) return true;
+        }
+        p += len;
+        if (*p == '|') p++;
+    }
+    return false;
+}
+
+int SignalGraph_AddNamedOutput(SignalGraph* g, SignalMode mode, const char* tokens,
+                               const char* const* inputNamesLower, int inputCount) {
+    int id = SignalGraph_AddOutput(g, mode);
+    if (id < 0 || !tokens || !inputNamesLower) return id;
+    if (inputCount > g->inputCount) inputCount = g->inputCount;
+    for (int i = 0; i < inputCount; ++i) {
+        const char* name = inputNamesLower[i];
+        if (!name || !NameHasAnyToken(name, tokens)) continue;
+        SignalGraph_Connect(g, id, i);
+        if (strstr(name, "alterna")) g->mode[id] = SIGNAL_TOGGLE;
+        else if (strstr(name, "todos")) g->mode[id] = SIGNAL_AND;
+    }
+    return id;
+}
+
+uint32_t SignalGraph_SetInputs(SignalGraph* g, uint32_t pressed) {
+    if (g->inputCount < SIGNAL_MAX_INPUTS) pressed &= (1u << g->inputCount) - 1u;
+    uint32_t changedInputs = pressed ^ g->inputs;
+    if (!changedInputs) return 0;
+
+    uint32_t rising = pressed & ~g->inputs;
+    uint32_t dirty = 0;
+    for (uint32_t m = changedInputs; m; m &= m - 1) dirty |= g->fanout[__builtin_ctz(m)];
+    g->inputs = pressed;
+
+    uint32_t before = g->outputs;
+    for (uint32_t m = dirty; m; m &= m - 1) {
+        int o = __builtin_ctz(m);
+        uint32_t bit = 1u << o;
+        uint32_t w = g->wires[o];
+        bool on;
+        switch (g->mode[o]) {
+            case SIGNAL_AND:    on = w != 0 && (pressed & w) == w; break;
+            case SIGNAL_TOGGLE: on = ((g->outputs & bit) != 0) ^ ((rising & w) != 0); break;
+            default:            on = (pressed & w) != 0; break;
+        }
+        if (on) g->outputs |= bit;
+        else    g->outputs &= ~bit;
+    }
+    return g->outputs ^ before;
+}
@@ -0,0 +1,50 @@
+#ifndef SIGNAL_GRAPH_H
+#define SIGNAL_GRAPH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SIGNAL_MAX_INPUTS  32   // botões: um bit cada
+#define SIGNAL_MAX_OUTPUTS 32   // atuadores (plataformas, ventiladores, portas...)
+
+typedef enum SignalMode {
+    SIGNAL_OR = 0,     // ligado enquanto qualquer botão ligado a ele estiver apertado
+    SIGNAL_AND,        // ligado só com todos os botões dele apertados
+    SIGNAL_TOGGLE      // troca de estado a cada botão que acaba de ser apertado
+} SignalMode;
+
+// Fiação botão -> atuador compilada na carga a partir dos nomes do TMX. Cada
+// atuador guarda a máscara dos botões que o controlam e cada botão a máscara dos
+// atuadores que ele alimenta; por tick a fase só entrega a máscara de botões
+// apertados e apenas os atuadores ligados aos bits que mudaram são reavaliados.
+typedef struct SignalGraph {
+    int inputCount;
+    int outputCount;
+    uint32_t wires[SIGNAL_MAX_OUTPUTS];    // bit i = botão i controla este atuador
+    uint32_t fanout[SIGNAL_MAX_INPUTS];    // bit o = atuador o ouve este botão
+    unsigned char mode[SIGNAL_MAX_OUTPUTS];
+    uint32_t inputs;                       // botões apertados no último SetInputs
+    uint32_t outputs;                      // estado atual de cada atuador
+} SignalGraph;
+
+void SignalGraph_Init(SignalGraph* g, int inputCount);
+
+// Devolve o índice do atuador (-1 se não couber)
+int SignalGraph_AddOutput(SignalGraph* g, SignalMode mode);
+void SignalGraph_Connect(SignalGraph* g, int output, int input);
+
+// Atuador ligado a todo botão cujo nome (em minúsculas) contém algum dos tokens
+// separados por '|', ex.: "elevador1|elevaodor1|elavador1". O próprio nome do
+// botão pode trocar o modo: "alterna" vira TOGGLE e "todos" vira AND.
+int SignalGraph_AddNamedOutput(SignalGraph* g, SignalMode mode, const char* tokens,
+                               const char* const* inputNamesLower, int inputCount);
+
+// Entrega os botões apertados; sem mudança não faz nada. Devolve a máscara de
+// atuadores que trocaram de estado.
+uint32_t SignalGraph_SetInputs(SignalGraph* g, uint32_t pressed);
+
+static inline bool SignalGraph_Output(const SignalGraph* g, int output) {
+    return output >= 0 && output < g->outputCount && (g->outputs & (1u << output)) != 0;
+}
+
+#endif
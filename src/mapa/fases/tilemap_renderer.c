@@ -0,0 +1,402 @@
+#include "tilemap_renderer.h"
+#include "rlgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TILEMAP_MAX_LAYERS 64
+
+// Bits de espelhamento que o Tiled guarda no alto do gid
+#define GID_FLIP_H    0x80000000u
+#define GID_FLIP_V    0x40000000u
+#define GID_FLIP_D    0x20000000u
+#define GID_MASK      0x1FFFFFFFu
+
+typedef struct {
+    unsigned int firstGid;
+    int tileW, tileH;
+    int columns, tileCount;
+    int spacing, margin;
+    int atlasY;               // linha do atlas onde a imagem do tileset começa
+    Image image;
+} TilesetInfo;
+
+typedef struct {
+    unsigned int* gids;
+    unsigned char alpha;
+} TileLayer;
+
+// --- Leitura de atributos (mesmo estilo de strstr usado em phase_common) ---
+
+static bool TagAttr(const char* tag, const char* tagEnd, const char* name, char* out, size_t outSize) {
+    char key[64];
+    snprintf(key, sizeof(key), " %s=\"", name);
+    const char* p = strstr(tag, key);
+    if (!p || p >= tagEnd) return false;
+    const char* v = p + strlen(key);
+    const char* q = strchr(v, '"');
+    if (!q || q > tagEnd) return false;
+    size_t len = (size_t)(q - v);
+    if (len >= outSize) len = outSize - 1;
+    memcpy(out, v, len);
+    out[len] = '\0';
+    return true;
+}
+
+static int TagAttrInt(const char* tag, const char* tagEnd, const char* name, int fallback) {
+    char buf[32];
+    return TagAttr(tag, tagEnd, name, buf, sizeof(buf)) ? atoi(buf) : fallback;
+}
+
+// false se o caminho não cabe em out (cortado abriria outro arquivo)
+static bool JoinPath(char* out, size_t outSize, const char* dir, const char* file) {
+    int n = (dir[0] == '\0') ? snprintf(out, outSize, "%s", file)
+                              : snprintf(out, outSize, "%s/%s", dir, file);
+    if (n < 0 || (size_t)n >= outSize) {
+        TraceLog(LOG_WARNING, "Tilemap: caminho longo demais: %s/%s", dir, file);
+        return false;
+    }
+    return true;
+}
+
+// Lê <tileset ...><image source=.../> a partir de tag; dir é a pasta do arquivo que contém a tag
+static bool ParseTilesetTag(const char* tag, const char* dir, TilesetInfo* ts) {
+    const char* tagEnd = strchr(tag, '>');
+    if (!tagEnd) return false;
+    ts->tileW = TagAttrInt(tag, tagEnd, "tilewidth", 0);
+    ts->tileH = TagAttrInt(tag, tagEnd, "tileheight", 0);
+    ts->columns = TagAttrInt(tag, tagEnd, "columns", 0);
+    ts->tileCount = TagAttrInt(tag, tagEnd, "tilecount", 0);
+    ts->spacing = TagAttrInt(tag, tagEnd, "spacing", 0);
+    ts->margin = TagAttrInt(tag, tagEnd, "margin", 0);
+    if (ts->tileW <= 0 || ts->tileH <= 0 || ts->columns <= 0) return false;
+
+    // Tilesets de imagens soltas (um arquivo por tile) não cabem no atlas
+    const char* img = strstr(tagEnd, "<image");
+    const char* close = strstr(tagEnd, "</tileset>");
+    if (!img || (close && img > close)) return false;
+    const char* imgEnd = strchr(img, '>');
+    char source[256];
+    if (!imgEnd || !TagAttr(img, imgEnd, "source", source, sizeof(source))) return false;
+
+    char path[512];
+    if (!JoinPath(path, sizeof(path), dir, source)) return false;
+    ts->image = LoadImage(path);
+    if (ts->image.data == NULL) {
+        TraceLog(LOG_WARNING, "Tilemap: imagem do tileset nao encontrada: %s", path);
+        return false;
+    }
+    ImageFormat(&ts->image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    return true;
+}
+
+static bool LoadTileset(const char* tag, const char* tmxDir, TilesetInfo* ts) {
+    const char* tagEnd = strchr(tag, '>');
+    if (!tagEnd) return false;
+    ts->firstGid = (unsigned int)TagAttrInt(tag, tagEnd, "firstgid", 1);
+
+    char source[256];
+    if (!TagAttr(tag, tagEnd, "source", source, sizeof(source))) {
+        return ParseTilesetTag(tag, tmxDir, ts); // tileset embutido no TMX
+    }
+
+    char path[512];
+    if (!JoinPath(path, sizeof(path), tmxDir, source)) return false;
+    char* tsx = FileExists(path) ? LoadFileText(path) : NULL;
+    if (!tsx) {
+        TraceLog(LOG_WARNING, "Tilemap: tileset nao encontrado: %s", path);
+        return false;
+    }
+    char tsxDir[512];
+    snprintf(tsxDir, sizeof(tsxDir), "%s", GetDirectoryPath(path));
+    const char* t = strstr(tsx, "<tileset");
+    bool ok = t && ParseTilesetTag(t, tsxDir, ts);
+    UnloadFileText(tsx);
+    return ok;
+}
+
+// Lê os gids de uma <layer> em CSV; retorna NULL para camadas ocultas ou em outro formato
+static unsigned int* ParseLayer(const char* tag, int width, int height, unsigned char* alpha) {
+    const char* tagEnd = strchr(tag, '>');
+    if (!tagEnd) return NULL;
+    char buf[32];
+    if (TagAttr(tag, tagEnd, "visible", buf, sizeof(buf)) && buf[0] == '0') return NULL;
+    float opacity = TagAttr(tag, tagEnd, "opacity", buf, sizeof(buf)) ? (float)atof(buf) : 1.0f;
+    *alpha = (unsigned char)(opacity < 0.0f ? 0 : opacity > 1.0f ? 255 : opacity * 255.0f);
+
+    const char* data = strstr(tagEnd, "<data");
+    const char* layerEnd = strstr(tagEnd, "</layer>");
+    if (!data || (layerEnd && data > layerEnd)) return NULL;
+    const char* dataEnd = strchr(data, '>');
+    if (!dataEnd || !TagAttr(data, dataEnd, "encoding", buf, sizeof(buf)) || strcmp(buf, "csv") != 0) {
+        TraceLog(LOG_WARNING, "Tilemap: camada sem encoding csv ignorada");
+        return NULL;
+    }
+
+    int count = width * height;
+    unsigned int* gids = (unsigned int*)calloc((size_t)count, sizeof(unsigned int));
+    if (!gids) return NULL;
+    const char* p = dataEnd + 1;
+    for (int i = 0; i < count; ++i) {
+        char* next;
+        gids[i] = (unsigned int)strtoul(p, &next, 10);
+        if (next == p) break;
+        p = next;
+        while (*p == ',' || *p == '\n' || *p == '\r' || *p == ' ') ++p;
+    }
+    return gids;
+}
+
+static const TilesetInfo* FindTileset(const TilesetInfo* sets, int count, unsigned int gid) {
+    const TilesetInfo* best = NULL;
+    for (int i = 0; i < count; ++i) {
+        if (sets[i].firstGid <= gid && (!best || sets[i].firstGid > best->firstGid)) best = &sets[i];
+    }
+    return best;
+}
+
+// --- Montagem dos chunks ---
+
+static void PushVertex(Mesh* m, int* v, float x, float y, Vector2 uv, unsigned char alpha) {
+    m->vertices[*v * 3 + 0] = x;
+    m->vertices[*v * 3 + 1] = y;
+    m->vertices[*v * 3 + 2] = 0.0f;
+    m->texcoords[*v * 2 + 0] = uv.x;
+    m->texcoords[*v * 2 + 1] = uv.y;
+    m->colors[*v * 4 + 0] = 255;
+    m->colors[*v * 4 + 1] = 255;
+    m->colors[*v * 4 + 2] = 255;
+    m->colors[*v * 4 + 3] = alpha;
+    (*v)++;
+}
+
+// Escreve os 6 vértices de um tile; retorna false se o gid não pertence a nenhum tileset
+static bool PushTile(Mesh* m, int* v, const TilesetInfo* sets, int setCount, float atlasW, float atlasH,
+                     unsigned int raw, int tx, int ty, int mapTileW, int mapTileH, unsigned char alpha) {
+    unsigned int gid = raw & GID_MASK;
+    const TilesetInfo* ts = FindTileset(sets, setCount, gid);
+    if (!ts) return false;
+    int local = (int)(gid - ts->firstGid);
+    if (ts->tileCount > 0 && local >= ts->tileCount) return false;
+
+    int col = local % ts->columns, row = local / ts->columns;
+    float sx = (float)(ts->margin + col * (ts->tileW + ts->spacing));
+    float sy = (float)(ts->atlasY + ts->margin + row * (ts->tileH + ts->spacing));
+    float u0 = sx / atlasW, u1 = (sx + ts->tileW) / atlasW;
+    float v0 = sy / atlasH, v1 = (sy + ts->tileH) / atlasH;
+
+    // Cantos na ordem TL, TR, BR, BL; o Tiled aplica diagonal, depois H, depois V
+    Vector2 uv[4] = { {u0, v0}, {u1, v0}, {u1, v1}, {u0, v1} };
+    Vector2 tmp;
+    if (raw & GID_FLIP_D) { tmp = uv[1]; uv[1] = uv[3]; uv[3] = tmp; }
+    if (raw & GID_FLIP_H) { tmp = uv[0]; uv[0] = uv[1]; uv[1] = tmp; tmp = uv[3]; uv[3] = uv[2]; uv[2] = tmp; }
+    if (raw & GID_FLIP_V) { tmp = uv[0]; uv[0] = uv[3]; uv[3] = tmp; tmp = uv[1]; uv[1] = uv[2]; uv[2] = tmp; }
+
+    // Tiles maiores que a grade são alinhados pela base, como no Tiled
+    float x0 = (float)(tx * mapTileW);
+    float y1 = (float)((ty + 1) * mapTileH);
+    float x1 = x0 + ts->tileW, y0 = y1 - ts->tileH;
+
+    PushVertex(m, v, x0, y0, uv[0], alpha);
+    PushVertex(m, v, x0, y1, uv[3], alpha);
+    PushVertex(m, v, x1, y1, uv[2], alpha);
+    PushVertex(m, v, x0, y0, uv[0], alpha);
+    PushVertex(m, v, x1, y1, uv[2], alpha);
+    PushVertex(m, v, x1, y0, uv[1], alpha);
+    return true;
+}
+
+static void BuildChunk(TilemapRenderer* r, TilemapChunk* chunk, int cx, int cy,
+                       const TileLayer* layers, int layerCount,
+                       const TilesetInfo* sets, int setCount, int maxTileW, int maxTileH) {
+    int x0 = cx * TILEMAP_CHUNK_TILES, y0 = cy * TILEMAP_CHUNK_TILES;
+    int x1 = x0 + TILEMAP_CHUNK_TILES, y1 = y0 + TILEMAP_CHUNK_TILES;
+    if (x1 > r->width) x1 = r->width;
+    if (y1 > r->height) y1 = r->height;
+
+    // Tiles grandes passam da borda do chunk para cima e para a direita
+    chunk->bounds = (Rectangle){
+        (float)(x0 * r->tileW), (float)(y0 * r->tileH - (maxTileH - r->tileH)),
+        (float)((x1 - x0) * r->tileW + (maxTileW - r->tileW)), (float)((y1 - y0) * r->tileH + (maxTileH - r->tileH))
+    };
+    chunk->empty = true;
+
+    int tiles = 0;
+    for (int l = 0; l < layerCount; ++l)
+        for (int y = y0; y < y1; ++y)
+            for (int x = x0; x < x1; ++x)
+                if ((layers[l].gids[y * r->width + x] & GID_MASK) != 0) tiles++;
+    if (tiles == 0) return;
+
+    Mesh m = {0};
+    m.vertices = (float*)MemAlloc((unsigned int)(tiles * 6 * 3 * sizeof(float)));
+    m.texcoords = (float*)MemAlloc((unsigned int)(tiles * 6 * 2 * sizeof(float)));
+    m.colors = (unsigned char*)MemAlloc((unsigned int)(tiles * 6 * 4));
+    if (!m.vertices || !m.texcoords || !m.colors) {
+        MemFree(m.vertices); MemFree(m.texcoords); MemFree(m.colors);
+        return;
+    }
+
+    float atlasW = (float)r->atlas.width, atlasH = (float)r->atlas.height;
+    int v = 0;
+    for (int l = 0; l < layerCount; ++l) {
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                unsigned int raw = layers[l].gids[y * r->width + x];
+                if ((raw & GID_MASK) == 0) continue;
+                PushTile(&m, &v, sets, setCount, atlasW, atlasH, raw, x, y, r->tileW, r->tileH, layers[l].alpha);
+            }
+        }
+    }
+    if (v == 0) { UnloadMesh(m); return; }
+
+    m.vertexCount = v;
+    m.triangleCount = v / 3;
+    UploadMesh(&m, false);
+    chunk->mesh = m;
+    chunk->empty = false;
+}
+
+bool TilemapRendererLoad(TilemapRenderer* r, const char* tmxPath) {
+    memset(r, 0, sizeof(*r));
+    char* xml = LoadFileText(tmxPath);
+    if (!xml) return false;
+
+    const char* mapTag = strstr(xml, "<map");
+    const char* mapEnd = mapTag ? strchr(mapTag, '>') : NULL;
+    if (!mapEnd) { UnloadFileText(xml); return false; }
+    r->width = TagAttrInt(mapTag, mapEnd, "width", 0);
+    r->height = TagAttrInt(mapTag, mapEnd, "height", 0);
+    r->tileW = TagAttrInt(mapTag, mapEnd, "tilewidth", 0);
+    r->tileH = TagAttrInt(mapTag, mapEnd, "tileheight", 0);
+    if (r->width <= 0 || r->height <= 0 || r->tileW <= 0 || r->tileH <= 0) { UnloadFileText(xml); return false; }
+
+    char tmxDir[512];
+    snprintf(tmxDir, sizeof(tmxDir), "%s", GetDirectoryPath(tmxPath));
+
+    // Tilesets: se qualquer um faltar, o chamador usa o PNG pré-renderizado
+    TilesetInfo sets[TILEMAP_MAX_TILESETS];
+    int setCount = 0;
+    bool ok = true;
+    for (const char* t = strstr(mapEnd, "<tileset"); t && ok; t = strstr(t + 8, "<tileset")) {
+        if (setCount >= TILEMAP_MAX_TILESETS) { ok = false; break; }
+        memset(&sets[setCount], 0, sizeof(sets[setCount]));
+        if (LoadTileset(t, tmxDir, &sets[setCount])) setCount++;
+        else ok = false;
+    }
+    if (setCount == 0) ok = false;
+
+    TileLayer layers[TILEMAP_MAX_LAYERS];
+    int layerCount = 0;
+    for (const char* l = strstr(mapEnd, "<layer "); l && ok && layerCount < TILEMAP_MAX_LAYERS; l = strstr(l + 7, "<layer ")) {
+        unsigned char alpha = 255;
+        unsigned int* gids = ParseLayer(l, r->width, r->height, &alpha);
+        if (gids) layers[layerCount++] = (TileLayer){ gids, alpha };
+    }
+    UnloadFileText(xml);
+    if (layerCount == 0) ok = false;
+
+    // Atlas: imagens dos tilesets empilhadas verticalmente
+    int maxTileW = r->tileW, maxTileH = r->tileH;
+    if (ok) {
+        int atlasW = 0, atlasH = 0;
+        for (int i = 0; i < setCount; ++i) {
+            sets[i].atlasY = atlasH;
+            atlasH += sets[i].image.height;
+            if (sets[i].image.width > atlasW) atlasW = sets[i].image.width;
+            if (sets[i].tileW > maxTileW) maxTileW = sets[i].tileW;
+            if (sets[i].tileH > maxTileH) maxTileH = sets[i].tileH;
+        }
+        Image atlas = GenImageColor(atlasW, atlasH, BLANK);
+        for (int i = 0; i < setCount; ++i) {
+            Image* img = &sets[i].image;
+            ImageDraw(&atlas, *img, (Rectangle){ 0, 0, (float)img->width, (float)img->height },
+                      (Rectangle){ 0, (float)sets[i].atlasY, (float)img->width, (float)img->height }, WHITE);
+        }
+        r->atlas = LoadTextureFromImage(atlas);
+        UnloadImage(atlas);
+        ok = r->atlas.id != 0;
+    }
+    for (int i = 0; i < setCount; ++i) UnloadImage(sets[i].image);
+
+    if (ok) {
+        SetTextureFilter(r->atlas, TEXTURE_FILTER_POINT);
+        r->material = LoadMaterialDefault();
+        r->material.maps[MATERIAL_MAP_ALBEDO].texture = r->atlas;
+
+        r->chunkCols = (r->width + TILEMAP_CHUNK_TILES - 1) / TILEMAP_CHUNK_TILES;
+        r->chunkRows = (r->height + TILEMAP_CHUNK_TILES - 1) / TILEMAP_CHUNK_TILES;
+        r->chunks = (TilemapChunk*)calloc((size_t)(r->chunkCols * r->chunkRows), sizeof(TilemapChunk));
+        ok = r->chunks != NULL;
+    }
+    if (ok) {
+        for (int cy = 0; cy < r->chunkRows; ++cy)
+            for (int cx = 0; cx < r->chunkCols; ++cx)
+                BuildChunk(r, &r->chunks[cy * r->chunkCols + cx], cx, cy, layers, layerCount,
+                           sets, setCount, maxTileW, maxTileH);
+    }
+    for (int i = 0; i < layerCount; ++i) free(layers[i].gids);
+
+    r->ready = ok;
+    if (!ok) TilemapRendererUnload(r);
+    return ok;
+}
+
+void TilemapRendererDraw(const TilemapRenderer* r, Camera2D camera) {
+    if (!r->ready) return;
+    float zoom = camera.zoom > 0.0f ? camera.zoom : 1.0f;
+    Rectangle view = {
+        camera.target.x - camera.offset.x / zoom, camera.target.y - camera.offset.y / zoom,
+        GetScreenWidth() / zoom, GetScreenHeight() / zoom
+    };
+    // Identidade: a câmera já está na modelview do BeginMode2D
+    Matrix identity = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+
+    // DrawMesh não passa pelo lote da rlgl: envia o que estiver pendente antes
+    rlDrawRenderBatchActive();
+    rlDisableBackfaceCulling(); // o eixo Y invertido do 2D inverte a orientação dos triângulos
+    for (int i = 0; i < r->chunkCols * r->chunkRows; ++i) {
+        const TilemapChunk* c = &r->chunks[i];
+        if (c->empty || !CheckCollisionRecs(c->bounds, view)) continue;
+        DrawMesh(c->mesh, r->material, identity);
+    }
+    rlEnableBackfaceCulling();
+}
+
+void TilemapRendererUnload(TilemapRenderer* r) {
+    if (r->chunks) {
+        for (int i = 0; i < r->chunkCols * r->chunkRows; ++i)
+            if (!r->chunks[i].empty) UnloadMesh(r->chunks[i].mesh);
+        free(r->chunks);
+    }
+    // UnloadMaterial também descarregaria a textura; o atlas é liberado aqui
+    if (r->material.maps) MemFree(r->material.maps);
+    if (r->atlas.id != 0) UnloadTexture(r->atlas);
+    memset(r, 0, sizeof(*r));
+}
+
+// --- Fundo da fase ---
+
+bool PhaseBackgroundLoad(PhaseBackground* bg, const char* tmxPath, const char* pngPath) {
+    memset(bg, 0, sizeof(*bg));
+    if (TilemapRendererLoad(&bg->tiles, tmxPath)) {
+        bg->width = bg->tiles.width * bg->tiles.tileW;
+        bg->height = bg->tiles.height * bg->tiles.tileH;
+        return true;
+    }
+    bg->baked = LoadTexture(pngPath);
+    bg->width = bg->baked.width;
+    bg->height = bg->baked.height;
+    return bg->baked.id != 0;
+}
+
+void PhaseBackgroundDraw(const PhaseBackground* bg, Camera2D camera) {
+    if (bg->tiles.ready) TilemapRendererDraw(&bg->tiles, camera);
+    else DrawTexture(bg->baked, 0, 0, WHITE);
+}
+
+void PhaseBackgroundUnload(PhaseBackground* bg) {
+    TilemapRendererUnload(&bg->tiles);
+    if (bg->baked.id != 0) UnloadTexture(bg->baked);
+    memset(bg, 0, sizeof(*bg));
+}
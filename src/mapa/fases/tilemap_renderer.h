@@ -0,0 +1,45 @@
+#ifndef TILEMAP_RENDERER_H
+#define TILEMAP_RENDERER_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#define TILEMAP_CHUNK_TILES   32   // chunks de 32x32 tiles
+#define TILEMAP_MAX_TILESETS  32
+
+typedef struct TilemapChunk {
+    Rectangle bounds;   // área coberta no mapa (px), usada para descartar fora da tela
+    Mesh mesh;          // todas as camadas do chunk, na ordem do TMX
+    bool empty;
+} TilemapChunk;
+
+// Desenha as camadas de tiles do TMX direto dos tilesets (.tsx). Os tilesets são
+// montados num único atlas e cada chunk vira um vertex buffer estático na carga,
+// então o mapa inteiro custa um draw call por chunk visível.
+typedef struct TilemapRenderer {
+    bool ready;
+    Texture2D atlas;
+    Material material;
+    int tileW, tileH;         // tamanho do tile do mapa (px)
+    int width, height;        // tamanho do mapa (tiles)
+    int chunkCols, chunkRows;
+    TilemapChunk* chunks;
+} TilemapRenderer;
+
+bool TilemapRendererLoad(TilemapRenderer* r, const char* tmxPath);
+void TilemapRendererDraw(const TilemapRenderer* r, Camera2D camera);
+void TilemapRendererUnload(TilemapRenderer* r);
+
+// Fundo da fase: tiles do TMX quando todos os tilesets estão disponíveis,
+// senão o PNG pré-renderizado de sempre.
+typedef struct PhaseBackground {
+    TilemapRenderer tiles;
+    Texture2D baked;
+    int width, height;        // tamanho do mapa (px)
+} PhaseBackground;
+
+bool PhaseBackgroundLoad(PhaseBackground* bg, const char* tmxPath, const char* pngPath);
+void PhaseBackgroundDraw(const PhaseBackground* bg, Camera2D camera);
+void PhaseBackgroundUnload(PhaseBackground* bg);
+
+#endif
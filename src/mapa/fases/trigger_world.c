@@ -0,0 +1,99 @@
+#include "trigger_world.h"
+#include <string.h>
+
+void TriggerWorld_Init(TriggerWorld* w) {
+    memset(w, 0, sizeof(*w));
+}
+
+void TriggerWorld_Free(TriggerWorld* w) {
+    CollisionGrid_Free(&w->grid);
+    memset(w, 0, sizeof(*w));
+}
+
+int TriggerWorld_Add(TriggerWorld* w, Rectangle volume, unsigned int bodyMask,
+                     TriggerHandler handler, void* user) {
+    if (w->count >= TRIGGER_MAX || volume.width <= 0 || volume.height <= 0) return -1;
+    int id = w->count++;
+    w->volumes[id].rect = volume;
+    w->bodyMask[id] = (unsigned char)(bodyMask & TRIGGER_ALL_BODIES);
+    w->occupancy[id] = 0;
+    w->wantsStay[id] = false;
+    w->handlers[id] = handler;
+    w->users[id] = user;
+    w->gridDirty = true;
+    // Corpos já rastreados precisam ser reavaliados contra o volume novo
+    for (int b = 0; b < TRIGGER_MAX_BODIES; ++b) w->tracked[b] = false;
+    return id;
+}
+
+void TriggerWorld_SetStay(TriggerWorld* w, int id, bool stay) {
+    if (id >= 0 && id < w->count) w->wantsStay[id] = stay;
+}
+
+static void Emit(TriggerWorld* w, int t, int body, Player* pl, TriggerEventType type) {
+    if (!w->handlers[t]) return;
+    TriggerEvent ev = { t, body, pl, type };
+    w->handlers[t](w->users[t], &ev);
+}
+
+void TriggerWorld_Update(TriggerWorld* w, Player** bodies, int bodyCount) {
+    if (w->count == 0) return;
+    if (w->gridDirty) {
+        CollisionGrid_Free(&w->grid);
+        CollisionGrid_Build(&w->grid, w->volumes, w->count, COLLISION_GRID_CELL);
+        w->gridDirty = false;
+    }
+    if (bodyCount > TRIGGER_MAX_BODIES) bodyCount = TRIGGER_MAX_BODIES;
+
+    int near[TRIGGER_MAX];
+    for (int b = 0; b < bodyCount; ++b) {
+        Player* pl = bodies[b];
+        if (!pl) continue;
+        Rectangle r = pl->rect;
+        if (w->tracked[b] && r.x == w->lastRect[b].x && r.y == w->lastRect[b].y &&
+            r.width == w->lastRect[b].width && r.height == w->lastRect[b].height) continue;
+        w->tracked[b] = true;
+        w->lastRect[b] = r;
+
+        uint64_t now = 0;
+        int n = CollisionGrid_Query(&w->grid, r, near, TRIGGER_MAX);
+        for (int i = 0; i < n; ++i) {
+            if (w->bodyMask[near[i]] & (1u << b)) now |= (uint64_t)1 << near[i];
+        }
+        uint64_t changed = now ^ w->inside[b];
+        if (!changed) continue;
+        w->inside[b] = now;
+        while (changed) {
+            int t = __builtin_ctzll(changed);
+            uint64_t bit = (uint64_t)1 << t;
+            changed &= changed - 1;
+            if (now & bit) {
+                w->occupancy[t] |= (unsigned char)(1u << b);
+                Emit(w, t, b, pl, TRIGGER_ENTER);
+            } else {
+                w->occupancy[t] &= (unsigned char)~(1u << b);
+                Emit(w, t, b, pl, TRIGGER_EXIT);
+            }
+        }
+    }
+
+    for (int t = 0; t < w->count; ++t) {
+        if (!w->wantsStay[t] || !w->occupancy[t]) continue;
+        for (int b = 0; b < bodyCount; ++b) {
+            if (w->occupancy[t] & (1u << b)) Emit(w, t, b, bodies[b], TRIGGER_STAY);
+        }
+    }
+}
+
+unsigned int TriggerWorld_Occupancy(const TriggerWorld* w, int id) {
+    if (id < 0 || id >= w->count) return 0;
+    return w->occupancy[id];
+}
+
+bool TriggerWorld_Contains(const TriggerWorld* w, int id, int body) {
+    return (TriggerWorld_Occupancy(w, id) >> body) & 1u;
+}
+
+void TriggerLatchOnEnter(void* user, const TriggerEvent* ev) {
+    if (ev->type == TRIGGER_ENTER) *(bool*)user = true;
+}
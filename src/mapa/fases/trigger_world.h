@@ -0,0 +1,69 @@
+#ifndef TRIGGER_WORLD_H
+#define TRIGGER_WORLD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../game/sim_types.h"
+#include "phase_common.h"
+#include "collision_grid.h"
+
+#define TRIGGER_MAX         64     // cabe numa máscara de 64 bits por corpo
+#define TRIGGER_MAX_BODIES  8      // cabe na máscara de ocupação de cada gatilho
+#define TRIGGER_ALL_BODIES  0xFFu
+
+typedef enum TriggerEventType {
+    TRIGGER_ENTER = 0,
+    TRIGGER_EXIT,
+    TRIGGER_STAY       // só para gatilhos com TriggerWorld_SetStay
+} TriggerEventType;
+
+typedef struct TriggerEvent {
+    int trigger;
+    int body;          // índice no vetor passado a TriggerWorld_Update
+    Player* player;
+    TriggerEventType type;
+} TriggerEvent;
+
+typedef void (*TriggerHandler)(void* user, const TriggerEvent* ev);
+
+// Volumes fixos (portas, botões, ventiladores) registrados na carga. A ocupação é
+// guardada dos dois lados: por gatilho (bit = corpo) e por corpo (bit = gatilho).
+// Um corpo que não se mexeu desde a última atualização não custa nada; um que se
+// mexeu consulta só os gatilhos da grade perto dele e gera ENTER/EXIT pela diferença
+// entre as máscaras.
+typedef struct TriggerWorld {
+    int count;
+    Colisao volumes[TRIGGER_MAX];
+    unsigned char bodyMask[TRIGGER_MAX];    // quais corpos este gatilho enxerga
+    unsigned char occupancy[TRIGGER_MAX];
+    bool wantsStay[TRIGGER_MAX];
+    TriggerHandler handlers[TRIGGER_MAX];
+    void* users[TRIGGER_MAX];
+
+    uint64_t inside[TRIGGER_MAX_BODIES];
+    Rectangle lastRect[TRIGGER_MAX_BODIES];
+    bool tracked[TRIGGER_MAX_BODIES];
+
+    CollisionGrid grid;
+    bool gridDirty;
+} TriggerWorld;
+
+void TriggerWorld_Init(TriggerWorld* w);
+void TriggerWorld_Free(TriggerWorld* w);
+
+// Devolve o id do gatilho, ou -1 se o volume é vazio ou não há espaço.
+// handler pode ser NULL (só ocupação consultada por TriggerWorld_Occupancy).
+int TriggerWorld_Add(TriggerWorld* w, Rectangle volume, unsigned int bodyMask,
+                     TriggerHandler handler, void* user);
+void TriggerWorld_SetStay(TriggerWorld* w, int id, bool stay);
+
+// Chamar depois que os corpos se moveram no tick (uma vez ou mais; sem movimento não há custo)
+void TriggerWorld_Update(TriggerWorld* w, Player** bodies, int bodyCount);
+
+unsigned int TriggerWorld_Occupancy(const TriggerWorld* w, int id);
+bool TriggerWorld_Contains(const TriggerWorld* w, int id, int body);
+
+// Handler pronto: user é um bool* que vira true no primeiro ENTER
+void TriggerLatchOnEnter(void* user, const TriggerEvent* ev);
+
+#endif
@@ -7,6 +7,8 @@
 #include "../audio/theme.h"
 #include "../player/player.h"
 #include "../game/game.h"
+#include "../interface/text_cache.h"
+#include "../interface/screen_assets.h"
 
 // Estrutura da árvore binária
 typedef struct NoFase {
@@ -36,38 +38,21 @@ void Conectar(NoFase* pai, NoFase* esq, NoFase* dir) {
 
 void AtualizarDesbloqueios(NoFase** fases, int faseConcluida);
 
-typedef struct {
-    Texture2D inicial;
-    Texture2D parcial;
-    Texture2D completo;
-} MapaTexturas;
-
-static void CarregarMapaTexturas(MapaTexturas* mapas) {
-    mapas->inicial = LoadTexture("assets/map/mapafases/1.png");
-    mapas->parcial = LoadTexture("assets/map/mapafases/123.png");
-    mapas->completo = LoadTexture("assets/map/mapafases/12345.png");
-}
-
-static void DescarregarMapaTexturas(MapaTexturas* mapas) {
-    if (mapas->inicial.id > 0) UnloadTexture(mapas->inicial);
-    if (mapas->parcial.id > 0) UnloadTexture(mapas->parcial);
-    if (mapas->completo.id > 0) UnloadTexture(mapas->completo);
-}
-
-static Texture2D* SelecionarMapaAtual(MapaTexturas* mapas, NoFase* fase2, NoFase* fase3, NoFase* fase4) {
-    Texture2D* selecionada = &mapas->inicial;
+// As três artes do mapa ficam residentes (screen_assets); aqui só se escolhe qual mostrar
+static const Texture2D* SelecionarMapaAtual(NoFase* fase2, NoFase* fase3, NoFase* fase4) {
+    ScreenAsset selecionada = SCREEN_ASSET_MAPA_INICIAL;
 
     if (fase4 && fase4->desbloqueada) {
-        selecionada = &mapas->completo;
+        selecionada = SCREEN_ASSET_MAPA_COMPLETO;
     } else {
         bool ladoEsquerdoDesbloqueado = fase2 && fase2->desbloqueada;
         bool ladoDireitoDesbloqueado = fase3 && fase3->desbloqueada;
         if (ladoEsquerdoDesbloqueado || ladoDireitoDesbloqueado) {
-            selecionada = &mapas->parcial;
+            selecionada = SCREEN_ASSET_MAPA_PARCIAL;
         }
     }
 
-    return selecionada;
+    return ScreenAssets_Get(selecionada);
 }
 
 static NoFase* CriarArvoreFases(NoFase** fases) {
@@ -135,8 +120,6 @@ void AtualizarDesbloqueios(NoFase** fases, int faseConcluida) {
 bool MostrarMapaFases(void) {
     const int screenWidth = 1920;
     const int screenHeight = 1080;
-    MapaTexturas mapas;
-    CarregarMapaTexturas(&mapas);
 
     NoFase* fases[6] = {0};
     NoFase* raiz = CriarArvoreFases(fases);
@@ -157,7 +140,7 @@ bool MostrarMapaFases(void) {
         Theme_Update();
         BeginDrawing();
         ClearBackground(BLACK);
-        DrawText("Carregando mapa...", 800, 500, 30, WHITE);
+        TextCache_Draw("Carregando mapa...", 800, 500, 30, WHITE);
         EndDrawing();
     }
 
@@ -166,7 +149,7 @@ bool MostrarMapaFases(void) {
         Theme_Update();
         BeginDrawing();
         ClearBackground(BLACK);
-        DrawText("Carregando mapa...", 800, 500, 30, WHITE);
+        TextCache_Draw("Carregando mapa...", 800, 500, 30, WHITE);
         EndDrawing();
     }
 
@@ -241,14 +224,14 @@ bool MostrarMapaFases(void) {
         BeginDrawing();
         ClearBackground((Color){35, 25, 10, 255});
 
-        Texture2D* mapaAtual = SelecionarMapaAtual(&mapas, fases[2], fases[3], fases[4]);
+        const Texture2D* mapaAtual = SelecionarMapaAtual(fases[2], fases[3], fases[4]);
 
         Rectangle srcMapa = {0, 0, (float)mapaAtual->width, (float)mapaAtual->height};
         Rectangle dstMapa = {0, 0, (float)screenWidth, (float)screenHeight};
         DrawTexturePro(*mapaAtual, srcMapa, dstMapa, (Vector2){0, 0}, 0.0f, WHITE);
 
-        DrawText("MAPA DE FASES", 780, 40, 40, YELLOW);
-        DrawText("ESC para voltar ao menu", 780, 100, 20, GRAY);
+        TextCache_Draw("MAPA DE FASES", 780, 40, 40, YELLOW);
+        TextCache_Draw("ESC para voltar ao menu", 780, 100, 20, GRAY);
 
         NoFase* faseAtual = fases[faseSelecionada];
         bool faseDisponivel = faseAtual && faseAtual->desbloqueada;
@@ -274,8 +257,8 @@ bool MostrarMapaFases(void) {
 
         if (confirmExit) {
             DrawRectangle(0, 0, screenWidth, screenHeight, (Color){0,0,0,180});
-            DrawText("Voltar ao menu?", 820, 480, 30, RAYWHITE);
-            DrawText("Y = Sim   N = Nao", 835, 520, 20, LIGHTGRAY);
+            TextCache_Draw("Voltar ao menu?", 820, 480, 30, RAYWHITE);
+            TextCache_Draw("Y = Sim   N = Nao", 835, 520, 20, LIGHTGRAY);
             if (IsKeyPressed(KEY_Y)) { sairDoMapa = true; }
             if (IsKeyPressed(KEY_N)) { confirmExit = false; }
         }
@@ -287,7 +270,6 @@ bool MostrarMapaFases(void) {
         // Atalho de Fase Teste removido
     }
 
-    DescarregarMapaTexturas(&mapas);
     LiberarFases(fases, 6);
     return false;
 }
@@ -3,18 +3,16 @@
 #include "../mapa/mapa_fases.h"
 #include "../game/game.h"
 #include "../ranking/ranking.h"
+#include "../interface/text_cache.h"
+#include "../interface/screen_assets.h"
 #include <string.h>
 
 // Ordem visual: JOGAR, RANKING, TROCAR USUARIO, INSTRUCOES
 typedef enum { OPC_JOGAR = 0, OPC_RANKING, OPC_TROCAR_USUARIO, OPC_INSTRUCOES, OPC_SAIR, TOTAL_OPCOES } MenuOpcao;
 
 bool MostrarMenu(void) {
-    // Usa a arte principal do menu
-    Texture2D background = LoadTexture("assets/menu/menu.png");
-    if (background.id == 0) {
-        // Fallback para o antigo nome se necessário
-        background = LoadTexture("assets/menu/menuaed.png");
-    }
+    // Usa a arte principal do menu (residente: não é recarregada a cada visita)
+    const Texture2D* background = ScreenAssets_Get(SCREEN_ASSET_MENU);
     int opcaoSelecionada = OPC_JOGAR;
 
     // Posições da seta (ajustáveis)
@@ -31,8 +29,8 @@ bool MostrarMenu(void) {
 
         // --- Fundo preenchendo toda a tela ---
         DrawTexturePro(
-            background,
-            (Rectangle){0, 0, background.width, background.height},
+            *background,
+            (Rectangle){0, 0, background->width, background->height},
             (Rectangle){0, 0, GetScreenWidth(), GetScreenHeight()},
             (Vector2){0, 0},
             0.0f,
@@ -45,13 +43,13 @@ bool MostrarMenu(void) {
 
         if ((int)(GetTime() * 2) % 2 == 0) {
             if (opcaoSelecionada == OPC_JOGAR)
-                DrawText(">", posJogar.x - 80, posJogar.y, fontSize, corSeta);
+                TextCache_Draw(">", posJogar.x - 80, posJogar.y, fontSize, corSeta);
             else if (opcaoSelecionada == OPC_RANKING)
-                DrawText(">", posRanking.x - 80, posRanking.y, fontSize, corSeta);
+                TextCache_Draw(">", posRanking.x - 80, posRanking.y, fontSize, corSeta);
             else if (opcaoSelecionada == OPC_TROCAR_USUARIO)
-                DrawText(">", posTrocar.x - 80, posTrocar.y, fontSize, corSeta);
+                TextCache_Draw(">", posTrocar.x - 80, posTrocar.y, fontSize, corSeta);
             else if (opcaoSelecionada == OPC_INSTRUCOES)
-                DrawText(">", posInstrucoes.x - 80, posInstrucoes.y, fontSize, corSeta);
+                TextCache_Draw(">", posInstrucoes.x - 80, posInstrucoes.y, fontSize, corSeta);
             // Oculta indicador para SAIR
         }
 
@@ -60,7 +58,7 @@ bool MostrarMenu(void) {
 
         // Mostra usuário atual
         const char* uname = Game_GetPlayerName();
-        DrawText(uname && uname[0] ? uname : "SEM USUARIO", 20, GetScreenHeight() - 40, 20, GRAY);
+        TextCache_Draw(uname && uname[0] ? uname : "SEM USUARIO", 20, GetScreenHeight() - 40, 20, GRAY);
 
         EndDrawing();
 
@@ -86,7 +84,6 @@ bool MostrarMenu(void) {
                         continue;
                     }
                 }
-                UnloadTexture(background);
                 return true; // apenas retorna — o main chamará o mapa
             }
             else if (opcaoSelecionada == OPC_TROCAR_USUARIO) {
@@ -98,19 +95,14 @@ bool MostrarMenu(void) {
             }
             else if (opcaoSelecionada == OPC_RANKING) {
                 MostrarRanking();
-                background = LoadTexture("assets/menu/menu.png");
-                if (background.id == 0) background = LoadTexture("assets/menu/menuaed.png");
             }
             else if (opcaoSelecionada == OPC_INSTRUCOES) {
                 MostrarInstrucoes(); // abre tela de instruções
-                background = LoadTexture("assets/menu/menu.png"); // recarrega ao voltar
-                if (background.id == 0) background = LoadTexture("assets/menu/menuaed.png");
             }
             // Removido: ação de SAIR
         }
     }
 
-    UnloadTexture(background);
     return false;
 }
 
@@ -122,16 +114,16 @@ void MostrarInstrucoes(void) {
         BeginDrawing();
         ClearBackground(BLACK);
 
-        DrawText("INSTRUÇÕES:", 100, 100, 50, YELLOW);
-        DrawText("Watergirl:", 120, 200, 30, WHITE);
-        DrawText("Use W/A/D para mover", 120, 250, 30, WHITE);
-        DrawText("Fireboy:", 120, 400, 30, WHITE);
-        DrawText("Use as setas para mover", 120, 450, 30, WHITE);
-        DrawText("Earthboy:", 120, 600, 30, WHITE);
-        DrawText("Use I/J/L para mover", 120, 650, 30, WHITE);
+        TextCache_Draw("INSTRUÇÕES:", 100, 100, 50, YELLOW);
+        TextCache_Draw("Watergirl:", 120, 200, 30, WHITE);
+        TextCache_Draw("Use W/A/D para mover", 120, 250, 30, WHITE);
+        TextCache_Draw("Fireboy:", 120, 400, 30, WHITE);
+        TextCache_Draw("Use as setas para mover", 120, 450, 30, WHITE);
+        TextCache_Draw("Earthboy:", 120, 600, 30, WHITE);
+        TextCache_Draw("Use I/J/L para mover", 120, 650, 30, WHITE);
 
         if ((int)(GetTime() * 2) % 2 == 0)
-            DrawText("Pressione ESC para voltar", 120, 800, 30, GRAY);
+            TextCache_Draw("Pressione ESC para voltar", 120, 800, 30, GRAY);
 
         EndDrawing();
 
@@ -175,12 +167,12 @@ bool PromptPlayerName(void) {
 
         BeginDrawing();
         ClearBackground(BLACK);
-        DrawText("DIGITE SEU NOME:", 700, 400, 40, RAYWHITE);
+        TextCache_Draw("DIGITE SEU NOME:", 700, 400, 40, RAYWHITE);
         DrawRectangle(680, 460, 560, 60, (Color){30,30,30,255});
-        DrawText(buffer[0] ? buffer : "_", 700, 470, 40, GOLD);
-        DrawText("ENTER para confirmar | ESC para cancelar", 650, 540, 20, GRAY);
+        TextCache_Draw(buffer[0] ? buffer : "_", 700, 470, 40, GOLD);
+        TextCache_Draw("ENTER para confirmar | ESC para cancelar", 650, 540, 20, GRAY);
         if (showError) {
-            DrawText("Nome invalido ou ja existe", 700, 520, 20, RED);
+            TextCache_Draw("Nome invalido ou ja existe", 700, 520, 20, RED);
         }
         EndDrawing();
     }
@@ -1,67 +1,313 @@
 #include "box.h"
 #include <math.h>
 #include "../player/player.h"
+#include "../mapa/fases/collision_grid.h"
+#include "../mapa/fases/kinematic_world.h"
+#include "../structure/quicksort.h"
+#include "../game/sim_fixed.h"
+#include "../game/sim_rect.h"
 
-// Parâmetros de física simples
-static const float kFriction = 0.85f;
-static const float kMaxSpeed = 6.0f;
-static const float kPushAccel = 1.2f;
+#define BOX_PUSH_TOLERANCE 6.0f
+#define BOX_STOP_SPEED     0.05f
 
-void BoxInit(Box* b, Rectangle ground, float x, float width, float height) {
-    b->rect = (Rectangle){ x, ground.y - height, width, height };
+void BoxInit(Box* b, Rectangle rect) {
+    b->rect = rect;
     b->velX = 0.0f;
+    b->velY = 0.0f;
+    b->sleeping = false;
+    b->stillTicks = 0;
 }
 
-void BoxHandlePush(Box* b, Player* p, int keyLeft, int keyRight) {
-    if (!CheckCollisionRecs(p->rect, b->rect)) return;
-
-    float pLeft = p->rect.x;
-    float pRight = p->rect.x + p->rect.width;
-    float pTop = p->rect.y;
-    float pBottom = p->rect.y + p->rect.height;
-    float bLeft = b->rect.x;
-    float bRight = b->rect.x + b->rect.width;
-    float bTop = b->rect.y;
-    float bBottom = b->rect.y + b->rect.height;
+void BoxWake(Box* b) {
+    b->sleeping = false;
+    b->stillTicks = 0;
+}
 
-    float overlapX = fminf(pRight - bLeft, bRight - pLeft);
-    float overlapY = fminf(pBottom - bTop, bBottom - pTop);
+static bool PlayerPushingBox(const Player* pl, Rectangle box, bool pushRight) {
+    Rectangle expanded = box;
+    expanded.x -= 3.0f; expanded.width += 6.0f;
+    expanded.y -= 4.0f; expanded.height += 8.0f;
+    if (!SimRectsOverlap(pl->rect, expanded)) return false;
+    float pLeft = pl->rect.x;
+    float pRight = pl->rect.x + pl->rect.width;
+    if (pushRight) {
+        if (pLeft >= box.x) return false;
+        return fabsf(pRight - box.x) <= BOX_PUSH_TOLERANCE;
+    } else {
+        if (pRight <= box.x + box.width) return false;
+        return fabsf(pLeft - (box.x + box.width)) <= BOX_PUSH_TOLERANCE;
+    }
+}
 
+static void ResolvePlayerVsBox(Player* pl, const Box* box, float deltaX) {
+    if (!SimRectsOverlap(pl->rect, box->rect)) return;
+    float dx = (pl->rect.x + pl->rect.width*0.5f) - (box->rect.x + box->rect.width*0.5f);
+    float dy = (pl->rect.y + pl->rect.height*0.5f) - (box->rect.y + box->rect.height*0.5f);
+    float overlapX = (pl->rect.width*0.5f + box->rect.width*0.5f) - fabsf(dx);
+    float overlapY = (pl->rect.height*0.5f + box->rect.height*0.5f) - fabsf(dy);
+    if (overlapX <= 0 || overlapY <= 0) return;
     if (overlapX < overlapY) {
-        // Lateral
-        if (IsKeyDown(keyRight) && pRight > bLeft && pLeft < bLeft) {
-            p->rect.x = b->rect.x - p->rect.width;
-            b->velX += kPushAccel;
-        } else if (IsKeyDown(keyLeft) && pLeft < bRight && pRight > bRight) {
-            p->rect.x = b->rect.x + b->rect.width;
-            b->velX -= kPushAccel;
-        } else {
-            if (p->rect.x < b->rect.x) p->rect.x = b->rect.x - p->rect.width;
-            else p->rect.x = b->rect.x + b->rect.width;
-        }
+        if (dx > 0) pl->rect.x += overlapX;
+        else        pl->rect.x -= overlapX;
+        pl->velocity.x = 0;
     } else {
-        // Vertical
-        if (p->velocity.y > 0 && pBottom > bTop && pTop < bTop) {
-            p->rect.y = b->rect.y - p->rect.height;
-            p->velocity.y = 0;
-            p->isJumping = false;
-        } else if (p->velocity.y < 0 && pTop < bBottom && pBottom > bBottom) {
-            p->rect.y = b->rect.y + b->rect.height;
-            p->velocity.y = 0;
+        if (dy > 0 && pl->velocity.y < 0) {
+            pl->rect.y += overlapY;
+            pl->velocity.y = 0;
+        } else if (dy < 0 && pl->velocity.y >= 0) {
+            pl->rect.y -= overlapY;
+            pl->velocity.y = 0;
+            pl->isJumping = false;
+            pl->rect.x += deltaX; // quem está em cima anda junto
         }
     }
 }
 
-void BoxUpdate(Box* b, Rectangle ground) {
-    if (fabsf(b->velX) < 0.05f) b->velX = 0.0f; else b->velX *= kFriction;
-    if (b->velX > kMaxSpeed) b->velX = kMaxSpeed; else if (b->velX < -kMaxSpeed) b->velX = -kMaxSpeed;
-    b->rect.x += b->velX;
+// Contra outra caixa (otherBox) só quem está em cima cede na vertical: o apoio
+// nunca é empurrado para baixo por quem caiu nele
+static void ResolveBoxVsRect(Box* box, Rectangle bloco, bool otherBox) {
+    if (!SimRectsOverlap(box->rect, bloco)) return;
+    float dx = (box->rect.x + box->rect.width*0.5f) - (bloco.x + bloco.width*0.5f);
+    float dy = (box->rect.y + box->rect.height*0.5f) - (bloco.y + bloco.height*0.5f);
+    float overlapX = (box->rect.width*0.5f + bloco.width*0.5f) - fabsf(dx);
+    float overlapY = (box->rect.height*0.5f + bloco.height*0.5f) - fabsf(dy);
+    if (overlapX <= 0 || overlapY <= 0) return;
+    if (overlapX < overlapY) {
+        if (dx > 0) box->rect.x += overlapX;
+        else        box->rect.x -= overlapX;
+        box->velX = 0;
+    } else {
+        if (dy > 0 && otherBox) return;
+        if (dy > 0) box->rect.y += overlapY;
+        else        box->rect.y -= overlapY;
+        box->velY = 0;
+    }
+}
+
+// Mundo e depois as outras caixas da ilha (sólidas umas para as outras)
+static void ResolveBoxVsWorld(Box* box, CollisionGrid* grid, Box* const* island, int islandCount) {
+    int near[COLLISION_GRID_QUERY_MAX];
+    int n = CollisionGrid_Query(grid, PhaseResolveReach(box->rect, 0.0f), near, COLLISION_GRID_QUERY_MAX);
+    for (int i = 0; i < n; ++i) ResolveBoxVsRect(box, grid->rects[near[i]].rect, false);
+    for (int i = 0; i < islandCount; ++i) {
+        if (island[i] != box) ResolveBoxVsRect(box, island[i]->rect, true);
+    }
+}
+
+// Dormindo: acorda se uma colisão móvel entrou na caixa ou se o apoio embaixo sumiu
+// (onBox = está apoiada em outra caixa da ilha, que não está na grade)
+static bool BoxDisturbed(const Box* b, const BoxParams* prm, CollisionGrid* grid, bool onBox) {
+    for (int d = 0; d < grid->dynamicCount; ++d) {
+        if (SimRectsOverlap(b->rect, grid->rects[grid->dynamicList[d]].rect)) return true;
+    }
+    if (prm->gravity <= 0.0f || onBox) return false;
+    Rectangle below = { b->rect.x, b->rect.y + b->rect.height, b->rect.width, 1.0f };
+    return !CollisionGrid_AreaSolid(grid, below);
+}
+
+// +1 empurrada para a direita, -1 para a esquerda, 0 parada
+static int BoxPushDirection(const Box* b, const BoxParams* prm, const BoxPusher* pushers, int pusherCount) {
+    int pushRight = 0, pushLeft = 0;
+    for (int i = 0; i < pusherCount; ++i) {
+        if (pushers[i].right && PlayerPushingBox(pushers[i].pl, b->rect, true)) pushRight++;
+        else if (pushers[i].left && PlayerPushingBox(pushers[i].pl, b->rect, false)) pushLeft++;
+    }
+    if (pushRight >= prm->pushersNeeded && pushRight >= pushLeft) return 1;
+    if (pushLeft >= prm->pushersNeeded && pushLeft > pushRight) return -1;
+    return 0;
+}
+
+static void BoxIntegrate(Box* b, const BoxParams* prm, int push) {
+    SimNum vx = SimNum_FromFloat(b->velX);
+    SimNum accel = SimNum_FromFloat(prm->pushAccel);
+    SimNum maxSpeed = SimNum_FromFloat(prm->maxSpeed);
+    if (push != 0) vx += (push > 0) ? accel : -accel;
+    vx = SimNum_Mul(vx, SimNum_FromFloat(prm->friction));
+    if (SimNum_Abs(vx) < SIM_NUM(BOX_STOP_SPEED)) vx = 0;
+    if (vx > maxSpeed) vx = maxSpeed;
+    if (vx < -maxSpeed) vx = -maxSpeed;
+    b->velX = SimNum_ToFloat(vx);
+    if (prm->gravity > 0.0f) {
+        SimNum vy = SimNum_FromFloat(b->velY) + SimNum_FromFloat(prm->gravity);
+        if (vy > SimNum_FromFloat(prm->maxFall)) vy = SimNum_FromFloat(prm->maxFall);
+        b->velY = SimNum_ToFloat(vy);
+    }
+}
+
+// Eixo X e depois Y: varredura contra túnel, limites do mapa, mundo e ilha
+static void BoxMove(Box* b, const BoxParams* prm, CollisionGrid* grid, float worldWidth,
+                    Box* const* island, int islandCount) {
+    Rectangle from = b->rect;
+    b->rect.x = SimNum_ToFloat(SimNum_FromFloat(b->rect.x) + SimNum_FromFloat(b->velX));
+    if (PhaseSweepClamp(grid, &b->rect, from)) b->velX = 0.0f;
     if (b->rect.x < 0) { b->rect.x = 0; b->velX = 0; }
-    if (b->rect.x + b->rect.width > ground.width) { b->rect.x = ground.width - b->rect.width; b->velX = 0; }
+    if (b->rect.x > worldWidth - b->rect.width) { b->rect.x = worldWidth - b->rect.width; b->velX = 0; }
+    ResolveBoxVsWorld(b, grid, island, islandCount);
+
+    if (prm->gravity > 0.0f) {
+        from = b->rect;
+        b->rect.y = SimNum_ToFloat(SimNum_FromFloat(b->rect.y) + SimNum_FromFloat(b->velY));
+        if (PhaseSweepClamp(grid, &b->rect, from)) b->velY = 0.0f;
+        ResolveBoxVsWorld(b, grid, island, islandCount);
+    }
+}
+
+static bool BodiesTouch(Rectangle a, Rectangle b) {
+    return a.x <= b.x + b.width + BOX_CONTACT_SLOP && b.x <= a.x + a.width + BOX_CONTACT_SLOP &&
+           a.y <= b.y + b.height + BOX_CONTACT_SLOP && b.y <= a.y + a.height + BOX_CONTACT_SLOP;
+}
+
+// top apoiado em base: sobrepõe na horizontal e o fundo de top encosta no topo de base
+static bool RestsOn(Rectangle top, Rectangle base) {
+    if (top.x + top.width <= base.x || top.x >= base.x + base.width) return false;
+    return fabsf(top.y + top.height - base.y) <= BOX_CONTACT_SLOP;
+}
+
+// Deslocamento lateral da barra/elevador em que a caixa estava apoiada no último tick
+static bool KinematicCarry(const Box* b, const KinematicWorld* kinematics, float* carryX) {
+    *carryX = 0.0f;
+    if (!kinematics) return false;
+    for (int k = 0; k < kinematics->count; ++k) {
+        Vector2 v = kinematics->velocity[k];
+        if (v.x == 0.0f) continue;
+        Rectangle now = KinematicWorld_Rect(kinematics, k);
+        Rectangle before = { now.x - v.x, now.y - v.y, now.width, now.height };
+        if (RestsOn(b->rect, before)) { *carryX = v.x; return true; }
+    }
+    return false;
+}
+
+static int IslandRoot(int* parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// A raiz é sempre o menor índice: caixas vêm antes dos jogadores, então toda ilha
+// com caixa tem uma caixa como raiz e a ordem das ilhas não depende da varredura
+static void IslandUnion(int* parent, int a, int b) {
+    a = IslandRoot(parent, a);
+    b = IslandRoot(parent, b);
+    if (a < b) parent[b] = a;
+    else if (b < a) parent[a] = b;
 }
 
-void BoxDraw(const Box* b) {
-    DrawRectangleRec(b->rect, DARKBROWN);
-    DrawRectangleLines((int)b->rect.x, (int)b->rect.y, (int)b->rect.width, (int)b->rect.height, BLACK);
+typedef struct BoxSortKey {
+    float key;
+    int index;
+} BoxSortKey;
+
+static int CompareSortKey(const void* a, const void* b) {
+    const BoxSortKey* ka = (const BoxSortKey*)a;
+    const BoxSortKey* kb = (const BoxSortKey*)b;
+    if (ka->key != kb->key) return ka->key < kb->key ? -1 : 1;
+    return ka->index - kb->index;
 }
 
+void BoxStep(Box* boxes, int boxCount, const BoxParams* prm, const BoxPusher* pushers, int pusherCount,
+             CollisionGrid* grid, const KinematicWorld* kinematics, float worldWidth) {
+    if (!boxes || boxCount <= 0) return;
+    if (boxCount > BOX_ISLAND_MAX) boxCount = BOX_ISLAND_MAX;
+    if (pusherCount > BOX_ISLAND_MAX - boxCount) pusherCount = BOX_ISLAND_MAX - boxCount;
+    int bodyCount = boxCount + pusherCount;
+
+    // Corpos: caixas em [0, boxCount), jogadores depois
+    Rectangle body[BOX_ISLAND_MAX];
+    for (int b = 0; b < boxCount; ++b) body[b] = boxes[b].rect;
+    for (int p = 0; p < pusherCount; ++p) body[boxCount + p] = pushers[p].pl->rect;
+
+    // Fase larga: ordena por x e varre; jogador com jogador não forma contato
+    BoxSortKey byX[BOX_ISLAND_MAX];
+    int parent[BOX_ISLAND_MAX];
+    for (int i = 0; i < bodyCount; ++i) {
+        byX[i] = (BoxSortKey){ body[i].x, i };
+        parent[i] = i;
+    }
+    quicksort(byX, bodyCount, sizeof(byX[0]), CompareSortKey);
+    for (int i = 0; i < bodyCount; ++i) {
+        int a = byX[i].index;
+        float reach = body[a].x + body[a].width + BOX_CONTACT_SLOP;
+        for (int j = i + 1; j < bodyCount && byX[j].key <= reach; ++j) {
+            int c = byX[j].index;
+            if (a >= boxCount && c >= boxCount) continue;
+            if (BodiesTouch(body[a], body[c])) IslandUnion(parent, a, c);
+        }
+    }
+
+    for (int root = 0; root < boxCount; ++root) {
+        if (IslandRoot(parent, root) != root) continue;
+
+        Box* island[BOX_ISLAND_MAX];
+        int memberCount = 0;
+        Player* riders[BOX_ISLAND_MAX];
+        int riderCount = 0;
+        for (int i = root; i < bodyCount; ++i) {
+            if (IslandRoot(parent, i) != root) continue;
+            if (i < boxCount) island[memberCount++] = &boxes[i];
+            else riders[riderCount++] = pushers[i - boxCount].pl;
+        }
+
+        // Apoio de cada caixa dentro da ilha, empurrões e barras: decide se a ilha acorda
+        int support[BOX_ISLAND_MAX], push[BOX_ISLAND_MAX];
+        float carry[BOX_ISLAND_MAX];
+        bool awake = false;
+        for (int m = 0; m < memberCount; ++m) {
+            Box* b = island[m];
+            support[m] = -1;
+            for (int o = 0; o < memberCount && support[m] < 0; ++o) {
+                if (o != m && RestsOn(b->rect, island[o]->rect)) support[m] = o;
+            }
+            push[m] = BoxPushDirection(b, prm, pushers, pusherCount);
+            bool carried = KinematicCarry(b, kinematics, &carry[m]);
+            if (!b->sleeping || push[m] != 0 || carried || BoxDisturbed(b, prm, grid, support[m] >= 0)) awake = true;
+        }
+
+        if (!awake) {
+            for (int r = 0; r < riderCount; ++r)
+                for (int m = 0; m < memberCount; ++m) ResolvePlayerVsBox(riders[r], island[m], 0.0f);
+            continue;
+        }
+
+        // De baixo para cima: o apoio anda antes e quem está em cima recebe o deltaX dele
+        BoxSortKey order[BOX_ISLAND_MAX];
+        for (int m = 0; m < memberCount; ++m) order[m] = (BoxSortKey){ -(island[m]->rect.y + island[m]->rect.height), m };
+        quicksort(order, memberCount, sizeof(order[0]), CompareSortKey);
+
+        float deltaX[BOX_ISLAND_MAX] = {0};
+        bool allStill = true;
+        for (int k = 0; k < memberCount; ++k) {
+            int m = order[k].index;
+            Box* b = island[m];
+            if (b->sleeping) BoxWake(b);
+            Rectangle start = b->rect;
+            float carryX = carry[m] + (support[m] >= 0 ? deltaX[support[m]] : 0.0f);
+            if (carryX != 0.0f) b->rect.x += carryX;
+            BoxIntegrate(b, prm, push[m]);
+            BoxMove(b, prm, grid, worldWidth, island, memberCount);
+            deltaX[m] = b->rect.x - start.x;
+
+            bool still = push[m] == 0 && fabsf(b->rect.x - start.x) < BOX_SLEEP_EPS && fabsf(b->rect.y - start.y) < BOX_SLEEP_EPS;
+            b->stillTicks = still ? b->stillTicks + 1 : 0;
+            if (b->stillTicks < BOX_SLEEP_TICKS) allStill = false;
+        }
+
+        // Jogadores batem nas caixas já resolvidas; quem está em cima anda junto
+        for (int r = 0; r < riderCount; ++r) {
+            for (int k = 0; k < memberCount; ++k) {
+                int m = order[k].index;
+                ResolvePlayerVsBox(riders[r], island[m], deltaX[m]);
+            }
+        }
+
+        // A ilha dorme inteira ou não dorme
+        if (allStill) {
+            for (int m = 0; m < memberCount; ++m) {
+                island[m]->sleeping = true;
+                island[m]->velX = 0.0f;
+                island[m]->velY = 0.0f;
+            }
+        }
+    }
+}
@@ -1,21 +1,60 @@
-// Caixa empurrável reutilizável pelas fases
+// Caixa empurrável reutilizável pelas fases: um corpo só para todas
+// (empurrão por vários jogadores, gravidade, atrito, contato com mundo, com as
+// outras caixas e com os jogadores, empilhamento, sono por ilha)
 #ifndef BOX_H
 #define BOX_H
 
-#include "raylib.h"
+#include <stdbool.h>
+#include "../game/sim_types.h"
 
 // Encaminhamento para evitar dependência direta aqui
 typedef struct Player Player;
+struct CollisionGrid;
+struct KinematicWorld;
+
+#define BOX_SLEEP_TICKS 30      // ticks parada até dormir
+#define BOX_SLEEP_EPS   0.01f   // px/tick abaixo disso conta como parada
+#define BOX_ISLAND_MAX  16      // caixas + jogadores por chamada de BoxStep
+#define BOX_CONTACT_SLOP 1.0f   // folga que ainda conta como encostado/apoiado
+
+// Ajustes de cada fase (a fase 1 exige os três jogadores, a 4 só dois e tem gravidade)
+typedef struct BoxParams {
+    int pushersNeeded;
+    float pushAccel;
+    float friction;     // multiplicador de velX por tick
+    float maxSpeed;
+    float gravity;      // 0 = caixa presa na altura
+    float maxFall;
+} BoxParams;
 
 typedef struct Box {
     Rectangle rect;
     float velX;
+    float velY;
+    bool sleeping;
+    int stillTicks;
 } Box;
 
-void BoxInit(Box* b, Rectangle ground, float x, float width, float height);
-void BoxHandlePush(Box* b, Player* p, int keyLeft, int keyRight);
-void BoxUpdate(Box* b, Rectangle ground);
-void BoxDraw(const Box* b);
+// Quem pode empurrar neste tick e para que lado está andando
+typedef struct BoxPusher {
+    Player* pl;
+    bool left;
+    bool right;
+} BoxPusher;
 
-#endif
+void BoxInit(Box* b, Rectangle rect);
+void BoxWake(Box* b);
 
+// Um tick (SIM_TICK_DT) de todas as caixas da fase. Caixas e jogadores que se
+// tocam formam ilhas; cada ilha é resolvida junta, de baixo para cima (o apoio
+// antes de quem está em cima, que anda junto com ele), e só dorme inteira, quando
+// todas as caixas dela pararam. Uma ilha dormindo só confere se alguém empurra, se
+// uma colisão móvel encostou ou se o apoio sumiu; os jogadores continuam batendo e
+// subindo nas caixas normalmente. kinematics (pode ser NULL) leva junto a caixa
+// apoiada numa barra ou elevador que andou para o lado.
+void BoxStep(Box* boxes, int boxCount, const BoxParams* prm, const BoxPusher* pushers, int pusherCount,
+             struct CollisionGrid* grid, const struct KinematicWorld* kinematics, float worldWidth);
+
+void BoxDraw(const Box* b, Texture2D tex, Color fallback);
+
+#endif
@@ -0,0 +1,10 @@
+// Desenho da caixa, fora de box.c para o núcleo de simulação não depender da raylib
+#include "box.h"
+#include "raylib.h"
+
+void BoxDraw(const Box* b, Texture2D tex, Color fallback) {
+    if (tex.id != 0)
+        DrawTexturePro(tex, (Rectangle){0, 0, (float)tex.width, (float)tex.height}, b->rect, (Vector2){0, 0}, 0.0f, WHITE);
+    else
+        DrawRectangleRec(b->rect, fallback);
+}
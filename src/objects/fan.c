@@ -1,5 +1,5 @@
 #include "fan.h"
-#include "../player/player.h"
+#include "../mapa/fases/force_field.h"
 
 void FanInit(Fan* f, float x, float y, float w, float h, float strength) {
     f->rect = (Rectangle){ x, y, w, h };
@@ -16,10 +16,9 @@ void FanDraw(const Fan* f) {
     DrawRectangleLines((int)f->rect.x, (int)f->rect.y, (int)f->rect.width, (int)f->rect.height, (Color){120, 170, 220, 200});
 }
 
-void FanApply(const Fan* f, Player* p) {
-    if (!CheckCollisionRecs(p->rect, f->rect)) return;
-    // Aplica força vertical suave para cima; limita a velocidade ascendente
-    p->velocity.y -= f->strength;
-    if (p->velocity.y < -12.0f) p->velocity.y = -12.0f;
+int FanAddField(const Fan* f, ForceFieldWorld* w, int signal) {
+    // Força vertical suave para cima, mesma intensidade na coluna toda
+    return ForceFieldWorld_Add(w, f->rect, (Vector2){ 0.0f, -1.0f }, f->strength,
+                               FAN_MAX_RISE_SPEED, FORCE_FALLOFF_NONE, signal);
 }
 
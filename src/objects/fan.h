@@ -3,7 +3,9 @@
 
 #include "raylib.h"
 
-typedef struct Player Player; // forward declaration
+struct ForceFieldWorld;
+
+#define FAN_MAX_RISE_SPEED 12.0f   // teto da velocidade para cima dentro da coluna
 
 typedef struct Fan {
     Rectangle rect;   // área de efeito do ventilador (coluna de ar)
@@ -13,7 +15,9 @@ typedef struct Fan {
 
 void FanInit(Fan* f, float x, float y, float w, float h, float strength);
 void FanDraw(const Fan* f);
-void FanApply(const Fan* f, Player* p);
+// Registra a coluna de ar como campo de força para cima (signal: saída do
+// SignalGraph que liga o ventilador, -1 = sempre ligado). Devolve o id do campo.
+int FanAddField(const Fan* f, struct ForceFieldWorld* w, int signal);
 
 #endif
 
@@ -1,4 +1,5 @@
 #include "goal.h"
+#include "../interface/text_cache.h"
 #include "../player/player.h"
 
 void GoalInit(Goal* g, float x, float y, float w, float h, Color c) {
@@ -9,7 +10,7 @@ void GoalInit(Goal* g, float x, float y, float w, float h, Color c) {
 void GoalDraw(const Goal* g) {
     DrawRectangleRec(g->rect, g->color);
     DrawRectangleLines((int)g->rect.x, (int)g->rect.y, (int)g->rect.width, (int)g->rect.height, BLACK);
-    DrawText("CHEGADA", (int)(g->rect.x - 10), (int)(g->rect.y - 30), 20, g->color);
+    TextCache_Draw("CHEGADA", (int)(g->rect.x - 10), (int)(g->rect.y - 30), 20, g->color);
 }
 
 bool GoalReached(const Goal* g, const Player* p1, const Player* p2, const Player* p3) {
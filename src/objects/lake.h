@@ -1,7 +1,7 @@
 #ifndef LAKE_H
 #define LAKE_H
 
-#include "raylib.h"
+#include "../game/sim_types.h"
 
 typedef struct Player Player; // forward decl
 
@@ -23,4 +23,9 @@ void LakeDraw(const Lake* l);
 // Retorna true se o jogador MORRE ao tocar um lago de elemento diferente
 bool LakeHandlePlayer(const Lake* l, Player* p, LakeType playerElement);
 
+// Faixa letal do topo do lago (só depende do retângulo: dá para calcular na carga)
+Rectangle LakeKillBand(Rectangle lakeRect);
+// true se o corpo afundou o suficiente na faixa letal (não vale raspar a borda ou entrar pelo lado)
+bool LakeKillBandHit(Rectangle killBand, Rectangle body);
+
 #endif
@@ -0,0 +1,27 @@
+// Faixa letal dos lagos: só geometria, usada pelo índice de lagos do núcleo de
+// simulação e por LakeHandlePlayer
+#include "lake.h"
+#include "../game/sim_rect.h"
+
+Rectangle LakeKillBand(Rectangle lakeRect) {
+    // Zona de "superfície" que realmente mata quando o elemento é errado.
+    // Restrita ao topo do lago para evitar mortes ao passar por baixo de lagos suspensos
+    // ou encostar na lateral.
+    const float killBand = 8.0f; // px de faixa letal a partir da superfície
+    if (lakeRect.height > killBand) lakeRect.height = killBand; // só a faixa de cima
+    return lakeRect;
+}
+
+bool LakeKillBandHit(Rectangle killRect, Rectangle body) {
+    if (!SimRectsOverlap(body, killRect)) return false;
+
+    // Exige penetração vertical mínima dentro da faixa de topo
+    Rectangle overlap = SimRectIntersection(body, killRect);
+    float pBottom = body.y + body.height;
+    float lTop = killRect.y;
+    const float minDepthY = 4.0f;       // precisa afundar pelo menos 4px
+    const float minBottomInside = 2.0f; // base precisa cruzar 2px abaixo da borda
+    if (pBottom <= lTop + minBottomInside) return false; // só encostou na borda superior
+    if (overlap.height < minDepthY) return false;        // raspada/entrada lateral
+    return true;
+}
@@ -1,11 +1,9 @@
 #include "player.h"
+#include "../game/sim_clock.h"
+#include "../game/sim_input.h"
 
 void InitEarthboy(Player *p) {
-    p->rect = (Rectangle){100, 300, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT};
-    p->velocity = (Vector2){0, 0};
-    p->isJumping = false;
-    p->facingRight = true;
-    p->idle = true;
+    PlayerInitBody(p, (Rectangle){100, 300, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT});
 
     p->walkFrames[0] = LoadTexture("assets/earthboy/walk/WALK1.png");
     p->walkFrames[1] = LoadTexture("assets/earthboy/walk/WALK2.png");
@@ -27,11 +25,7 @@ void InitEarthboy(Player *p) {
 
 // --- FIREBOY ---
 void InitFireboy(Player *p) {
-    p->rect = (Rectangle){200, 700, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT};
-    p->velocity = (Vector2){0, 0};
-    p->isJumping = false;
-    p->facingRight = true;
-    p->idle = true;
+    PlayerInitBody(p, (Rectangle){200, 700, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT});
 
     p->walkFrames[0] = LoadTexture("assets/fireboy/walk/WALK1.png");
     p->walkFrames[1] = LoadTexture("assets/fireboy/walk/WALK2.png");
@@ -56,11 +50,7 @@ void InitFireboy(Player *p) {
 
 // --- WATERGIRL ---
 void InitWatergirl(Player *p) {
-    p->rect = (Rectangle){400, 700, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT};
-    p->velocity = (Vector2){0, 0};
-    p->isJumping = false;
-    p->facingRight = true;
-    p->idle = true;
+    PlayerInitBody(p, (Rectangle){400, 700, PLAYER_HITBOX_WIDTH, PLAYER_HITBOX_HEIGHT});
 
     p->walkFrames[0] = LoadTexture("assets/watergirl/walk/WALK1.png");
     p->walkFrames[1] = LoadTexture("assets/watergirl/walk/WALK2.png");
@@ -83,65 +73,8 @@ void InitWatergirl(Player *p) {
 
 // --- UPDATE genérico: teclas personalizadas ---
 void UpdatePlayer(Player *p, Rectangle ground, int keyLeft, int keyRight, int keyJump) {
-    bool moving = false;
-    const float MOVE_SPEED = 4.4f;
-
-    // Movimento horizontal
-    if (IsKeyDown(keyRight)) {
-        p->rect.x += MOVE_SPEED;
-        p->facingRight = true;
-        moving = true;
-    }
-    if (IsKeyDown(keyLeft)) {
-        p->rect.x -= MOVE_SPEED;
-        p->facingRight = false;
-        moving = true;
-    }
-
-    p->idle = !moving;
-
-    // Animação — troca de frames se estiver se movendo
-    if (moving) {
-    p->timer += GetFrameTime();
-    if (p->timer >= p->tempoFrame) {
-        p->frameAtual++;
-        if (p->frameAtual >= p->totalWalkFrames)
-            p->frameAtual = 0;
-        p->timer = 0.0f;
-        }
-    } 
-    else { // Idle
-        p->timer += GetFrameTime();
-        if (p->timer >= p->tempoFrame) {
-            p->frameAtual++;
-            if (p->frameAtual >= p->totalIdleFrames)
-                p->frameAtual = 0;
-            p->timer = 0.0f;
-        }
-    }
-
-
-    // Gravidade
-    p->velocity.y += 0.5f;
-    p->rect.y += p->velocity.y;
-
-    // Colisão com o chão
-    if (CheckCollisionRecs(p->rect, ground)) {
-        p->rect.y = ground.y - p->rect.height;
-        p->velocity.y = 0;
-        p->isJumping = false;
-    }
-
-    // Pulo
-    if (IsKeyPressed(keyJump) && !p->isJumping) {
-        p->velocity.y = -10.5f; // about one tile lower than antes (~1 bloco a menos)
-        p->isJumping = true;
-    }
-
-    // Limites da tela
-    if (p->rect.x < 0) p->rect.x = 0;
-    if (p->rect.x + p->rect.width > ground.width)
-        p->rect.x = ground.width - p->rect.width;
+    PlayerInput input = { IsKeyDown(keyLeft), IsKeyDown(keyRight), SimInput_Pressed(keyJump) };
+    UpdatePlayerWithInput(p, ground, input, SIM_TICK_DT);
 }
 
 // --- Desenho ---
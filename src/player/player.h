@@ -1,7 +1,7 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
-#include "raylib.h"
+#include "../game/sim_types.h"
 #include <stdbool.h>
 
 // Visual size of the sprites stays the same, but the hitbox is slightly narrower
@@ -11,12 +11,38 @@
 #define PLAYER_HITBOX_WIDTH 40.0f
 #define PLAYER_HITBOX_HEIGHT 55.0f
 
+#define PLAYER_MAX_CONTACTS 4
+
+// Contatos da última resolução contra o mundo (PhaseResolvePlayersVsWorld). Um
+// jogador parado no chão repete o mesmo tick (gravidade entra, a mesma
+// sobreposição sai); se o tick e o apoio são os mesmos, a resolução reaplica o
+// resultado guardado sem consultar a grade.
+typedef struct PlayerContacts {
+    bool valid;
+    const void* grid;                   // grade em que foi resolvido
+    unsigned int dynamicEpoch;          // CollisionGrid.dynamicEpoch naquele tick
+    bool nearDynamic;                   // a área consultada tocava algum dinâmico
+    Rectangle area;                     // área consultada
+    Rectangle from, enter;              // prevRect e rect antes de resolver
+    Vector2 enterVelocity;
+    bool enterJumping;
+    Rectangle rest;                     // como saiu da resolução
+    Vector2 restVelocity;
+    bool restJumping;
+    int ground;                         // colisão que segurou por baixo (-1 = nenhuma)
+    int count;                          // chão, paredes e teto que empurraram
+    int index[PLAYER_MAX_CONTACTS];
+    Rectangle rect[PLAYER_MAX_CONTACTS];
+} PlayerContacts;
+
 typedef struct Player {
     Rectangle rect;
+    Rectangle prevRect;   // posição no começo do tick (varredura contra túnel)
     Vector2 velocity;
     bool isJumping;
     bool facingRight;
     bool idle;
+    PlayerContacts contacts;
 
     Texture2D walkFrames[8];
     Texture2D idleFrames[4];
@@ -28,11 +54,24 @@ typedef struct Player {
     float timer;
 } Player;
 
+// Só o corpo (posição, velocidade, animação zerada), sem texturas: serve para
+// simular sem janela. As Init* abaixo chamam esta e carregam os sprites.
+void PlayerInitBody(Player *p, Rectangle rect);
 void InitEarthboy(Player *p);
 void InitFireboy(Player *p);
 void InitWatergirl(Player *p);
 
+// Estado das teclas de um jogador num frame (lido na thread da janela)
+typedef struct PlayerInput {
+    bool left;
+    bool right;
+    bool jumpPressed;
+} PlayerInput;
+
+// Um tick de simulação (SIM_TICK_DT); o pulo usa o toque travado por SimInput_Pressed
 void UpdatePlayer(Player *p, Rectangle ground, int keyLeft, int keyRight, int keyJump);
+// Mesmo passo, sem tocar no teclado: serve para simular fora da thread da janela
+void UpdatePlayerWithInput(Player *p, Rectangle ground, PlayerInput input, float dt);
 void DrawPlayer(Player p);
 void UnloadPlayer(Player *p);
 
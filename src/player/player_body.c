@@ -0,0 +1,88 @@
+// Corpo do jogador na simulação: sem texturas e sem teclado, para rodar também
+// no binário sem janela. Sprites, leitura de teclas e desenho ficam em player.c.
+#include "player.h"
+#include "../game/sim_fixed.h"
+#include "../game/sim_rect.h"
+
+void PlayerInitBody(Player *p, Rectangle rect) {
+    *p = (Player){0};
+    p->rect = rect;
+    p->prevRect = rect;
+    p->facingRight = true;
+    p->idle = true;
+    p->tempoFrame = 0.1f;
+}
+
+void UpdatePlayerWithInput(Player *p, Rectangle ground, PlayerInput input, float dt) {
+    bool moving = false;
+    const SimNum MOVE_SPEED = SIM_NUM(4.4f);
+    p->prevRect = p->rect;
+
+    // Movimento horizontal
+    SimNum x = SimNum_FromFloat(p->rect.x);
+    if (input.right) {
+        x += MOVE_SPEED;
+        p->facingRight = true;
+        moving = true;
+    }
+    if (input.left) {
+        x -= MOVE_SPEED;
+        p->facingRight = false;
+        moving = true;
+    }
+    // Velocidade lateral só vem de empurrões (vento) e decai a cada tick
+    if (p->velocity.x != 0.0f) {
+        SimNum vx = SimNum_FromFloat(p->velocity.x);
+        x += vx;
+        vx = SimNum_Mul(vx, SIM_NUM(0.85f));
+        if (SimNum_Abs(vx) < SIM_NUM(0.05f)) vx = 0;
+        p->velocity.x = SimNum_ToFloat(vx);
+    }
+    p->rect.x = SimNum_ToFloat(x);
+
+    p->idle = !moving;
+
+    // Animação — troca de frames se estiver se movendo
+    if (moving) {
+    p->timer += dt;
+    if (p->timer >= p->tempoFrame) {
+        p->frameAtual++;
+        if (p->frameAtual >= p->totalWalkFrames)
+            p->frameAtual = 0;
+        p->timer = 0.0f;
+        }
+    } 
+    else { // Idle
+        p->timer += dt;
+        if (p->timer >= p->tempoFrame) {
+            p->frameAtual++;
+            if (p->frameAtual >= p->totalIdleFrames)
+                p->frameAtual = 0;
+            p->timer = 0.0f;
+        }
+    }
+
+
+    // Gravidade
+    SimNum vy = SimNum_FromFloat(p->velocity.y) + SIM_NUM(0.5f);
+    p->velocity.y = SimNum_ToFloat(vy);
+    p->rect.y = SimNum_ToFloat(SimNum_FromFloat(p->rect.y) + vy);
+
+    // Colisão com o chão
+    if (SimRectsOverlap(p->rect, ground)) {
+        p->rect.y = ground.y - p->rect.height;
+        p->velocity.y = 0;
+        p->isJumping = false;
+    }
+
+    // Pulo
+    if (input.jumpPressed && !p->isJumping) {
+        p->velocity.y = SimNum_ToFloat(SIM_NUM(-10.5f)); // about one tile lower than antes (~1 bloco a menos)
+        p->isJumping = true;
+    }
+
+    // Limites da tela
+    if (p->rect.x < 0) p->rect.x = 0;
+    if (p->rect.x + p->rect.width > ground.width)
+        p->rect.x = ground.width - p->rect.width;
+}
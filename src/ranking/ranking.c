@@ -1,6 +1,7 @@
 #include "ranking.h"
 #include "raylib.h"
 #include "../audio/theme.h"
+#include "../interface/text_cache.h"
 #include <string.h>
 #include <stdio.h>
 #include "../structure/quicksort.h"
@@ -67,38 +68,55 @@ bool Ranking_NameExists(const char* name) {
     return false;
 }
 
-static void drawTime(float t, int x, int y, int fontSize, Color c) {
+#define RANK_VISIBLE 15
+
+// Linhas já formatadas da fase exibida; só são refeitas quando a fase ou a contagem mudam
+typedef struct {
+    int fase, count;
+    char titulo[16];
+    char nomes[RANK_VISIBLE][80];
+    char tempos[RANK_VISIBLE][32];
+} RankingLines;
+
+static void formatTime(char* buf, size_t size, float t) {
     int minutes = (int)(t / 60.0f);
     float secs = t - minutes*60;
-    char buf[64];
-    sprintf(buf, "%02d:%05.2f", minutes, secs);
-    DrawText(buf, x, y, fontSize, c);
+    snprintf(buf, size, "%02d:%05.2f", minutes, secs);
+}
+
+static void buildLines(RankingLines* l, int fase) {
+    l->fase = fase;
+    l->count = Ranking_GetCount(fase);
+    snprintf(l->titulo, sizeof(l->titulo), "Fase %d", fase);
+    for (int i = 0; i < l->count && i < RANK_VISIBLE; ++i) {
+        const RankEntry* e = Ranking_GetEntry(fase, i);
+        l->nomes[i][0] = l->tempos[i][0] = '\0';
+        if (!e) continue;
+        snprintf(l->nomes[i], sizeof(l->nomes[i]), "%2d. %s", i+1, e->name[0] ? e->name : "<anon>");
+        formatTime(l->tempos[i], sizeof(l->tempos[i]), e->timeSec);
+    }
 }
 
 void MostrarRanking(void) {
     int fase = 1;
+    RankingLines lines = { .fase = -1, .count = -1 };
     while (!WindowShouldClose()) {
         Theme_Update();
+        if (lines.fase != fase || lines.count != Ranking_GetCount(fase)) buildLines(&lines, fase);
+
         BeginDrawing();
         ClearBackground((Color){10, 10, 14, 255});
-        DrawText("RANKING", 820, 60, 50, YELLOW);
-        DrawText("LEFT/RIGHT: Fase | ESC: Voltar", 700, 120, 20, GRAY);
+        TextCache_Draw("RANKING", 820, 60, 50, YELLOW);
+        TextCache_Draw("LEFT/RIGHT: Fase | ESC: Voltar", 700, 120, 20, GRAY);
 
         // Fase selector
-        char titulo[64];
-        sprintf(titulo, "Fase %d", fase);
-        DrawText(titulo, 900, 170, 30, GOLD);
+        TextCache_Draw(lines.titulo, 900, 170, 30, GOLD);
 
-        int count = Ranking_GetCount(fase);
         int startY = 220;
         int lineH = 34;
-        for (int i = 0; i < count && i < 15; ++i) {
-            const RankEntry* e = Ranking_GetEntry(fase, i);
-            if (!e) continue;
-            char nameBuf[80];
-            sprintf(nameBuf, "%2d. %s", i+1, e->name[0] ? e->name : "<anon>");
-            DrawText(nameBuf, 700, startY + i*lineH, 28, RAYWHITE);
-            drawTime(e->timeSec, 1200, startY + i*lineH, 28, LIGHTGRAY);
+        for (int i = 0; i < lines.count && i < RANK_VISIBLE; ++i) {
+            TextCache_Draw(lines.nomes[i], 700, startY + i*lineH, 28, RAYWHITE);
+            TextCache_Draw(lines.tempos[i], 1200, startY + i*lineH, 28, LIGHTGRAY);
         }
 
         EndDrawing();
@@ -0,0 +1,357 @@
+#include "frame_capture.h"
+#include "rlgl.h"
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Acesso mínimo ao OpenGL para os PBOs (a raylib não expõe essas funções) ---
+#define CAP_GL_PIXEL_PACK_BUFFER 0x88EB
+#define CAP_GL_STREAM_READ       0x88E1
+#define CAP_GL_READ_ONLY         0x88B8
+#define CAP_GL_RGBA              0x1908
+#define CAP_GL_UNSIGNED_BYTE     0x1401
+
+#if defined(_WIN32)
+    #define CAP_APIENTRY __stdcall
+    __declspec(dllimport) void* __stdcall wglGetProcAddress(const char* name);
+    __declspec(dllimport) void __stdcall glReadPixels(int x, int y, int w, int h, unsigned int format, unsigned int type, void* data);
+    #define CAP_GET_PROC(name) wglGetProcAddress(name)
+    #define CAP_HAS_PBO 1
+#elif defined(__linux__)
+    #define CAP_APIENTRY
+    extern void* glXGetProcAddressARB(const unsigned char* name);
+    extern void glReadPixels(int x, int y, int w, int h, unsigned int format, unsigned int type, void* data);
+    #define CAP_GET_PROC(name) glXGetProcAddressARB((const unsigned char*)(name))
+    #define CAP_HAS_PBO 1
+#else
+    #define CAP_HAS_PBO 0
+#endif
+
+#if CAP_HAS_PBO
+typedef void  (CAP_APIENTRY *CapGenBuffersFn)(int n, unsigned int* ids);
+typedef void  (CAP_APIENTRY *CapDeleteBuffersFn)(int n, const unsigned int* ids);
+typedef void  (CAP_APIENTRY *CapBindBufferFn)(unsigned int target, unsigned int id);
+typedef void  (CAP_APIENTRY *CapBufferDataFn)(unsigned int target, ptrdiff_t size, const void* data, unsigned int usage);
+typedef void* (CAP_APIENTRY *CapMapBufferFn)(unsigned int target, unsigned int access);
+typedef unsigned char (CAP_APIENTRY *CapUnmapBufferFn)(unsigned int target);
+
+static CapGenBuffersFn    capGenBuffers;
+static CapDeleteBuffersFn capDeleteBuffers;
+static CapBindBufferFn    capBindBuffer;
+static CapBufferDataFn    capBufferData;
+static CapMapBufferFn     capMapBuffer;
+static CapUnmapBufferFn   capUnmapBuffer;
+#endif
+
+typedef struct {
+    unsigned char* pixels;
+    size_t capacity;
+    int width, height;
+    bool bottomUp;       // leitura do OpenGL vem de baixo para cima
+    long index;
+} CaptureFrame;
+
+// Fila SPSC: o loop do jogo só escreve em head, a thread só escreve em tail
+static CaptureFrame gSlots[FRAME_CAPTURE_QUEUE_SLOTS];
+static atomic_uint gHead;
+static atomic_uint gTail;
+static atomic_int gDropped;
+static atomic_bool gRunning;
+static sem_t gReady;
+static pthread_t gThread;
+
+static bool gActive = false;
+static FrameCaptureFormat gFormat = FRAME_CAPTURE_PNG;
+static char gDir[256] = "capturas";
+static int gFps = 60;
+static int gSession = 0;
+static long gFrameIndex = 0;
+
+// PBOs em pares: enquanto um recebe a leitura do frame atual, o outro é mapeado
+static bool gPboReady = false;
+static unsigned int gPbo[2];
+static size_t gPboSize[2];
+static int gPboW[2], gPboH[2];
+static bool gPboPending[2];
+static int gPboCur = 0;
+
+// Estado da thread de gravação
+static FILE* gY4m = NULL;
+static int gY4mW = 0, gY4mH = 0;
+static unsigned char* gScratch = NULL;
+static size_t gScratchSize = 0;
+
+static bool LoadPboFunctions(void) {
+#if CAP_HAS_PBO
+    capGenBuffers    = (CapGenBuffersFn)CAP_GET_PROC("glGenBuffers");
+    capDeleteBuffers = (CapDeleteBuffersFn)CAP_GET_PROC("glDeleteBuffers");
+    capBindBuffer    = (CapBindBufferFn)CAP_GET_PROC("glBindBuffer");
+    capBufferData    = (CapBufferDataFn)CAP_GET_PROC("glBufferData");
+    capMapBuffer     = (CapMapBufferFn)CAP_GET_PROC("glMapBuffer");
+    capUnmapBuffer   = (CapUnmapBufferFn)CAP_GET_PROC("glUnmapBuffer");
+    return capGenBuffers && capDeleteBuffers && capBindBuffer && capBufferData && capMapBuffer && capUnmapBuffer;
+#else
+    return false;
+#endif
+}
+
+// --- Lado da thread de gravação ---
+
+static unsigned char* Scratch(size_t size) {
+    if (size > gScratchSize) {
+        unsigned char* p = (unsigned char*)realloc(gScratch, size);
+        if (!p) return NULL;
+        gScratch = p;
+        gScratchSize = size;
+    }
+    return gScratch;
+}
+
+static const unsigned char* Row(const CaptureFrame* f, int y) {
+    int src = f->bottomUp ? (f->height - 1 - y) : y;
+    return f->pixels + (size_t)src * f->width * 4;
+}
+
+static void WriteImageFile(const CaptureFrame* f) {
+    size_t stride = (size_t)f->width * 4;
+    unsigned char* top = Scratch(stride * f->height);
+    if (!top) return;
+    for (int y = 0; y < f->height; ++y) memcpy(top + y * stride, Row(f, y), stride);
+    Image img = { top, f->width, f->height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    char path[320];
+    snprintf(path, sizeof(path), "%s/captura%02d_%06ld.%s", gDir, gSession, f->index,
+             gFormat == FRAME_CAPTURE_QOI ? "qoi" : "png");
+    ExportImage(img, path);
+}
+
+// YUV 4:2:0 de faixa completa (C420jpeg), BT.601 em aritmética inteira
+static void WriteY4mFrame(const CaptureFrame* f) {
+    if (!gY4m) {
+        char path[320];
+        snprintf(path, sizeof(path), "%s/captura%02d.y4m", gDir, gSession);
+        gY4m = fopen(path, "wb");
+        if (!gY4m) return;
+        gY4mW = f->width; gY4mH = f->height;
+        fprintf(gY4m, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", gY4mW, gY4mH, gFps);
+    }
+    if (f->width != gY4mW || f->height != gY4mH) return; // o vídeo não muda de tamanho
+
+    int w = f->width, h = f->height, cw = (w + 1) / 2, ch = (h + 1) / 2;
+    unsigned char* yPlane = Scratch((size_t)w * h + 2 * (size_t)cw * ch);
+    if (!yPlane) return;
+    unsigned char* uPlane = yPlane + (size_t)w * h;
+    unsigned char* vPlane = uPlane + (size_t)cw * ch;
+
+    for (int y = 0; y < h; ++y) {
+        const unsigned char* px = Row(f, y);
+        unsigned char* out = yPlane + (size_t)y * w;
+        for (int x = 0; x < w; ++x, px += 4) out[x] = (unsigned char)((77 * px[0] + 150 * px[1] + 29 * px[2]) >> 8);
+    }
+    for (int cy = 0; cy < ch; ++cy) {
+        const unsigned char* r0 = Row(f, cy * 2);
+        const unsigned char* r1 = Row(f, (cy * 2 + 1 < h) ? cy * 2 + 1 : cy * 2);
+        for (int cx = 0; cx < cw; ++cx) {
+            int x0 = cx * 2 * 4, x1 = (cx * 2 + 1 < w) ? x0 + 4 : x0;
+            int r = (r0[x0] + r0[x1] + r1[x0] + r1[x1]) >> 2;
+            int g = (r0[x0 + 1] + r0[x1 + 1] + r1[x0 + 1] + r1[x1 + 1]) >> 2;
+            int b = (r0[x0 + 2] + r0[x1 + 2] + r1[x0 + 2] + r1[x1 + 2]) >> 2;
+            int u = ((-43 * r - 85 * g + 128 * b) >> 8) + 128;
+            int v = ((128 * r - 107 * g - 21 * b) >> 8) + 128;
+            uPlane[(size_t)cy * cw + cx] = (unsigned char)(u < 0 ? 0 : (u > 255 ? 255 : u));
+            vPlane[(size_t)cy * cw + cx] = (unsigned char)(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+    }
+    fputs("FRAME\n", gY4m);
+    fwrite(yPlane, 1, (size_t)w * h + 2 * (size_t)cw * ch, gY4m);
+}
+
+static void* EncoderThread(void* arg) {
+    (void)arg;
+    for (;;) {
+        sem_wait(&gReady);
+        unsigned tail = atomic_load_explicit(&gTail, memory_order_relaxed);
+        unsigned head = atomic_load_explicit(&gHead, memory_order_acquire);
+        if (tail == head) {
+            if (!atomic_load(&gRunning)) break;
+            continue;
+        }
+        const CaptureFrame* f = &gSlots[tail % FRAME_CAPTURE_QUEUE_SLOTS];
+        if (gFormat == FRAME_CAPTURE_Y4M) WriteY4mFrame(f);
+        else WriteImageFile(f);
+        atomic_store_explicit(&gTail, tail + 1, memory_order_release);
+    }
+    if (gY4m) { fclose(gY4m); gY4m = NULL; }
+    free(gScratch);
+    gScratch = NULL;
+    gScratchSize = 0;
+    return NULL;
+}
+
+// --- Lado do loop do jogo ---
+
+// Copia para o próximo slot livre; com a fila cheia o frame é descartado (nunca espera)
+static void PushFrame(const void* pixels, int width, int height, bool bottomUp) {
+    unsigned head = atomic_load_explicit(&gHead, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&gTail, memory_order_acquire);
+    if (head - tail >= FRAME_CAPTURE_QUEUE_SLOTS) { atomic_fetch_add(&gDropped, 1); gFrameIndex++; return; }
+
+    CaptureFrame* f = &gSlots[head % FRAME_CAPTURE_QUEUE_SLOTS];
+    size_t size = (size_t)width * height * 4;
+    if (size > f->capacity) {
+        unsigned char* p = (unsigned char*)realloc(f->pixels, size);
+        if (!p) { atomic_fetch_add(&gDropped, 1); gFrameIndex++; return; }
+        f->pixels = p;
+        f->capacity = size;
+    }
+    memcpy(f->pixels, pixels, size);
+    f->width = width;
+    f->height = height;
+    f->bottomUp = bottomUp;
+    f->index = gFrameIndex++;
+    atomic_store_explicit(&gHead, head + 1, memory_order_release);
+    sem_post(&gReady);
+}
+
+#if CAP_HAS_PBO
+static void DrainPbo(int i) {
+    if (!gPboPending[i]) return;
+    gPboPending[i] = false;
+    capBindBuffer(CAP_GL_PIXEL_PACK_BUFFER, gPbo[i]);
+    void* data = capMapBuffer(CAP_GL_PIXEL_PACK_BUFFER, CAP_GL_READ_ONLY);
+    if (data) {
+        PushFrame(data, gPboW[i], gPboH[i], true);
+        capUnmapBuffer(CAP_GL_PIXEL_PACK_BUFFER);
+    }
+    capBindBuffer(CAP_GL_PIXEL_PACK_BUFFER, 0);
+}
+
+// Dispara a leitura do framebuffer atual para um PBO e entrega o do frame anterior
+static void ReadAsync(int width, int height) {
+    int cur = gPboCur, prev = cur ^ 1;
+    size_t size = (size_t)width * height * 4;
+    capBindBuffer(CAP_GL_PIXEL_PACK_BUFFER, gPbo[cur]);
+    if (gPboSize[cur] != size) {
+        capBufferData(CAP_GL_PIXEL_PACK_BUFFER, (ptrdiff_t)size, NULL, CAP_GL_STREAM_READ);
+        gPboSize[cur] = size;
+    }
+    glReadPixels(0, 0, width, height, CAP_GL_RGBA, CAP_GL_UNSIGNED_BYTE, NULL);
+    capBindBuffer(CAP_GL_PIXEL_PACK_BUFFER, 0);
+    gPboW[cur] = width;
+    gPboH[cur] = height;
+    gPboPending[cur] = true;
+    DrainPbo(prev);
+    gPboCur = prev;
+}
+#endif
+
+void FrameCapture_Configure(FrameCaptureFormat format, const char* outDir, int fps) {
+    if (gActive) return;
+    gFormat = format;
+    if (outDir && outDir[0]) {
+        strncpy(gDir, outDir, sizeof(gDir) - 1);
+        gDir[sizeof(gDir) - 1] = '\0';
+    }
+    if (fps > 0) gFps = fps;
+}
+
+bool FrameCapture_Start(void) {
+    if (gActive) return true;
+    if (!DirectoryExists(gDir) && MakeDirectory(gDir) != 0) {
+        TraceLog(LOG_WARNING, "CAPTURE: nao foi possivel criar a pasta %s", gDir);
+        return false;
+    }
+
+    atomic_store(&gHead, 0u);
+    atomic_store(&gTail, 0u);
+    atomic_store(&gDropped, 0);
+    atomic_store(&gRunning, true);
+    if (sem_init(&gReady, 0, 0) != 0) return false;
+    if (pthread_create(&gThread, NULL, EncoderThread, NULL) != 0) {
+        sem_destroy(&gReady);
+        return false;
+    }
+
+#if CAP_HAS_PBO
+    if (!gPboReady && LoadPboFunctions()) {
+        capGenBuffers(2, gPbo);
+        gPboReady = gPbo[0] != 0 && gPbo[1] != 0;
+    }
+#endif
+    if (!gPboReady) TraceLog(LOG_WARNING, "CAPTURE: PBO indisponivel, leitura sincrona");
+
+    gSession++;
+    gFrameIndex = 0;
+    gActive = true;
+    TraceLog(LOG_INFO, "CAPTURE: gravando em %s", gDir);
+    return true;
+}
+
+void FrameCapture_Stop(void) {
+    if (!gActive) return;
+#if CAP_HAS_PBO
+    // Entrega o que ainda está nos PBOs antes de fechar a fila
+    if (gPboReady) {
+        DrainPbo(gPboCur ^ 1);
+        DrainPbo(gPboCur);
+        capDeleteBuffers(2, gPbo);
+        gPbo[0] = gPbo[1] = 0;
+        gPboSize[0] = gPboSize[1] = 0;
+        gPboReady = false;
+    }
+#endif
+    atomic_store(&gRunning, false);
+    sem_post(&gReady);
+    pthread_join(gThread, NULL);
+    sem_destroy(&gReady);
+
+    for (int i = 0; i < FRAME_CAPTURE_QUEUE_SLOTS; ++i) {
+        free(gSlots[i].pixels);
+        memset(&gSlots[i], 0, sizeof(gSlots[i]));
+    }
+    if (atomic_load(&gDropped) > 0) TraceLog(LOG_WARNING, "CAPTURE: %d frames descartados", atomic_load(&gDropped));
+    gActive = false;
+}
+
+bool FrameCapture_IsActive(void) { return gActive; }
+int FrameCapture_Dropped(void) { return atomic_load(&gDropped); }
+
+void FrameCapture_Update(void) {
+    if (!IsKeyPressed(KEY_F8)) return;
+    if (gActive) FrameCapture_Stop();
+    else FrameCapture_Start();
+}
+
+void FrameCapture_Frame(void) {
+    if (!gActive) return;
+    rlDrawRenderBatchActive(); // o que ainda está no lote precisa chegar ao backbuffer
+    int w = GetRenderWidth(), h = GetRenderHeight();
+#if CAP_HAS_PBO
+    if (gPboReady) { ReadAsync(w, h); return; }
+#endif
+    unsigned char* pixels = rlReadScreenPixels(w, h); // já vem de cima para baixo
+    if (!pixels) return;
+    PushFrame(pixels, w, h, false);
+    MemFree(pixels);
+}
+
+void FrameCapture_FrameTexture(RenderTexture2D target) {
+    if (!gActive || target.id == 0) return;
+    rlDrawRenderBatchActive();
+    int w = target.texture.width, h = target.texture.height;
+#if CAP_HAS_PBO
+    if (gPboReady) {
+        rlEnableFramebuffer(target.id);
+        ReadAsync(w, h);
+        rlDisableFramebuffer();
+        return;
+    }
+#endif
+    void* pixels = rlReadTexturePixels(target.texture.id, w, h, target.texture.format);
+    if (!pixels) return;
+    PushFrame(pixels, w, h, true);
+    MemFree(pixels);
+}
@@ -0,0 +1,34 @@
+// Captura de frames sem travar o loop do jogo: a leitura da GPU usa dois
+// pixel buffer objects alternados (o frame N é copiado enquanto o N+1 é lido),
+// os pixels entram numa fila sem lock e uma thread separada grava os arquivos.
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define FRAME_CAPTURE_QUEUE_SLOTS 6   // frames em trânsito; fila cheia = frame descartado
+
+typedef enum {
+    FRAME_CAPTURE_PNG = 0,   // sequência de imagens
+    FRAME_CAPTURE_QOI,       // sequência de imagens (mais rápido de codificar)
+    FRAME_CAPTURE_Y4M        // vídeo bruto YUV 4:2:0 num único arquivo
+} FrameCaptureFormat;
+
+// Formato e pasta usados pela tecla F8 e por --capture
+void FrameCapture_Configure(FrameCaptureFormat format, const char* outDir, int fps);
+
+bool FrameCapture_Start(void);
+void FrameCapture_Stop(void);          // esvazia a fila e espera a thread terminar
+bool FrameCapture_IsActive(void);
+int FrameCapture_Dropped(void);
+
+// Chamar uma vez por frame junto com RenderScale_Update: F8 liga/desliga a gravação
+void FrameCapture_Update(void);
+
+// Lê o backbuffer; chamar depois de desenhar tudo e antes de EndDrawing
+void FrameCapture_Frame(void);
+// Lê uma RenderTexture (telas fora da janela, replays sem janela visível)
+void FrameCapture_FrameTexture(RenderTexture2D target);
+
+#endif
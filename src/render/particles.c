@@ -0,0 +1,226 @@
+#include "particles.h"
+#include "rlgl.h"
+#include <math.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PARTICLES_SSE 1
+#endif
+
+#define PARTICLE_DRAW_CHUNK 1024
+
+typedef struct {
+    ParticleKind kind;
+    Rectangle area;
+    float rate;
+    float acc;
+    bool active;
+} ParticleEmitter;
+
+// Estrutura de arrays: cada campo contíguo, para a integração andar de 4 em 4
+static float gX[PARTICLE_CAPACITY];
+static float gY[PARTICLE_CAPACITY];
+static float gVX[PARTICLE_CAPACITY];
+static float gVY[PARTICLE_CAPACITY];
+static float gAY[PARTICLE_CAPACITY];
+static float gLife[PARTICLE_CAPACITY];
+static float gInvLife[PARTICLE_CAPACITY];
+static float gSize[PARTICLE_CAPACITY];
+static Color gColor[PARTICLE_CAPACITY];
+static int gCount = 0;
+
+static ParticleEmitter gEmitters[PARTICLE_MAX_EMITTERS];
+static int gEmitterCount = 0;
+static unsigned int gSeed = 0x9E3779B9u;
+
+// xorshift32: barato e suficiente para efeitos visuais
+static float Rand01(void) {
+    gSeed ^= gSeed << 13;
+    gSeed ^= gSeed >> 17;
+    gSeed ^= gSeed << 5;
+    return (float)(gSeed >> 8) * (1.0f / 16777216.0f);
+}
+
+static float RandRange(float a, float b) {
+    return a + (b - a) * Rand01();
+}
+
+static void Spawn(float x, float y, float vx, float vy, float ay, float life, float size, Color c) {
+    if (gCount >= PARTICLE_CAPACITY || life <= 0.0f) return;
+    int i = gCount++;
+    gX[i] = x; gY[i] = y;
+    gVX[i] = vx; gVY[i] = vy; gAY[i] = ay;
+    gLife[i] = life; gInvLife[i] = 1.0f / life;
+    gSize[i] = size;
+    gColor[i] = c;
+}
+
+static Color LakeParticleColor(LakeType type) {
+    switch (type) {
+        case LAKE_WATER:  return (Color){ 170, 215, 255, 220 };
+        case LAKE_FIRE:   return (Color){ 255, 170, 60, 230 };
+        case LAKE_EARTH:  return (Color){ 170, 125, 75, 200 };
+        case LAKE_POISON: return (Color){ 140, 240, 110, 220 };
+        default:          return (Color){ 220, 220, 220, 200 };
+    }
+}
+
+static void EmitOne(const ParticleEmitter* e) {
+    const Rectangle* a = &e->area;
+    float x = a->x + Rand01() * a->width;
+    switch (e->kind) {
+        case PARTICLE_LAKE_WATER:
+            Spawn(x, a->y + Rand01() * 3.0f, RandRange(-6, 6), RandRange(-25, -10), 0.0f,
+                  RandRange(0.6f, 1.2f), 2.0f, LakeParticleColor(LAKE_WATER));
+            break;
+        case PARTICLE_LAKE_FIRE:
+            Spawn(x, a->y + Rand01() * 3.0f, RandRange(-10, 10), RandRange(-60, -30), -20.0f,
+                  RandRange(0.5f, 1.0f), RandRange(2.0f, 3.0f), LakeParticleColor(LAKE_FIRE));
+            break;
+        case PARTICLE_LAKE_EARTH:
+            Spawn(x, a->y + Rand01() * 3.0f, RandRange(-8, 8), RandRange(-15, -5), 10.0f,
+                  RandRange(0.5f, 0.9f), 2.0f, LakeParticleColor(LAKE_EARTH));
+            break;
+        case PARTICLE_LAKE_POISON:
+            Spawn(x, a->y + Rand01() * 3.0f, RandRange(-5, 5), RandRange(-30, -12), 0.0f,
+                  RandRange(0.6f, 1.2f), RandRange(2.0f, 3.0f), LakeParticleColor(LAKE_POISON));
+            break;
+        case PARTICLE_FAN_UP:
+        case PARTICLE_FAN_DOWN: {
+            // Atravessa a coluna inteira: a vida acompanha a altura da área
+            float speed = RandRange(250.0f, 350.0f);
+            bool up = e->kind == PARTICLE_FAN_UP;
+            Spawn(x, up ? a->y + a->height : a->y, 0.0f, up ? -speed : speed, 0.0f,
+                  a->height / speed, 2.0f, (Color){ 230, 245, 255, 140 });
+            break;
+        }
+        default: break;
+    }
+}
+
+void Particles_Reset(void) {
+    gCount = 0;
+    gEmitterCount = 0;
+}
+
+int Particles_AddEmitter(ParticleKind kind, Rectangle area, float rate) {
+    if (gEmitterCount >= PARTICLE_MAX_EMITTERS || area.width <= 0 || area.height <= 0) return -1;
+    ParticleEmitter* e = &gEmitters[gEmitterCount];
+    e->kind = kind;
+    e->area = area;
+    e->rate = rate;
+    e->acc = Rand01(); // desencontra os emissores para não soltarem todos no mesmo frame
+    e->active = true;
+    return gEmitterCount++;
+}
+
+void Particles_SetEmitterActive(int id, bool active) {
+    if (id < 0 || id >= gEmitterCount) return;
+    gEmitters[id].active = active;
+}
+
+void Particles_AddLakeEmitter(Rectangle lakeRect, LakeType type) {
+    ParticleKind kind;
+    switch (type) {
+        case LAKE_FIRE:   kind = PARTICLE_LAKE_FIRE; break;
+        case LAKE_EARTH:  kind = PARTICLE_LAKE_EARTH; break;
+        case LAKE_POISON: kind = PARTICLE_LAKE_POISON; break;
+        default:          kind = PARTICLE_LAKE_WATER; break;
+    }
+    // Só a faixa da superfície; ~1.5 partícula/s a cada tile de 27px
+    Rectangle surface = { lakeRect.x, lakeRect.y, lakeRect.width, 4.0f };
+    Particles_AddEmitter(kind, surface, lakeRect.width / 27.0f * 1.5f);
+}
+
+void Particles_BurstDeath(Rectangle playerRect, LakeType lakeType) {
+    Color c = LakeParticleColor(lakeType);
+    float cx = playerRect.x + playerRect.width * 0.5f;
+    float cy = playerRect.y + playerRect.height * 0.5f;
+    for (int i = 0; i < 80; ++i) {
+        float ang = Rand01() * 2.0f * PI;
+        float spd = RandRange(60.0f, 220.0f);
+        Spawn(cx + RandRange(-6, 6), cy + RandRange(-10, 10), cosf(ang) * spd, sinf(ang) * spd - 80.0f, 400.0f,
+              RandRange(0.5f, 1.0f), RandRange(2.0f, 4.0f), c);
+    }
+}
+
+static void Integrate(float dt) {
+    int i = 0;
+#ifdef PARTICLES_SSE
+    __m128 vdt = _mm_set1_ps(dt);
+    for (; i + 4 <= gCount; i += 4) {
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(&gVY[i]), _mm_mul_ps(_mm_loadu_ps(&gAY[i]), vdt));
+        __m128 x  = _mm_add_ps(_mm_loadu_ps(&gX[i]), _mm_mul_ps(_mm_loadu_ps(&gVX[i]), vdt));
+        __m128 y  = _mm_add_ps(_mm_loadu_ps(&gY[i]), _mm_mul_ps(vy, vdt));
+        __m128 l  = _mm_sub_ps(_mm_loadu_ps(&gLife[i]), vdt);
+        _mm_storeu_ps(&gVY[i], vy);
+        _mm_storeu_ps(&gX[i], x);
+        _mm_storeu_ps(&gY[i], y);
+        _mm_storeu_ps(&gLife[i], l);
+    }
+#endif
+    for (; i < gCount; ++i) {
+        gVY[i] += gAY[i] * dt;
+        gX[i] += gVX[i] * dt;
+        gY[i] += gVY[i] * dt;
+        gLife[i] -= dt;
+    }
+}
+
+// Remove as mortas trocando com a última viva (a ordem não importa no desenho)
+static void Compact(void) {
+    int i = 0;
+    while (i < gCount) {
+        if (gLife[i] > 0.0f) { ++i; continue; }
+        int last = --gCount;
+        gX[i] = gX[last]; gY[i] = gY[last];
+        gVX[i] = gVX[last]; gVY[i] = gVY[last]; gAY[i] = gAY[last];
+        gLife[i] = gLife[last]; gInvLife[i] = gInvLife[last];
+        gSize[i] = gSize[last]; gColor[i] = gColor[last];
+    }
+}
+
+void Particles_Update(float dt) {
+    if (dt <= 0.0f) return;
+    if (dt > 0.1f) dt = 0.1f; // volta de pausa/carregamento não vira um salto gigante
+
+    for (int e = 0; e < gEmitterCount; ++e) {
+        ParticleEmitter* em = &gEmitters[e];
+        if (!em->active) { em->acc = 0.0f; continue; }
+        em->acc += em->rate * dt;
+        while (em->acc >= 1.0f) { EmitOne(em); em->acc -= 1.0f; }
+    }
+
+    Integrate(dt);
+    Compact();
+}
+
+void Particles_Draw(void) {
+    if (gCount == 0) return;
+    unsigned int tex = rlGetTextureIdDefault();
+
+    // Mesma textura (branca 1x1) e mesmo modo para tudo: a rlgl junta os blocos
+    // numa única chamada, a menos que o buffer do lote encha no meio.
+    for (int start = 0; start < gCount; start += PARTICLE_DRAW_CHUNK) {
+        int end = start + PARTICLE_DRAW_CHUNK;
+        if (end > gCount) end = gCount;
+        rlCheckRenderBatchLimit(4 * (end - start));
+        rlSetTexture(tex);
+        rlBegin(RL_QUADS);
+        for (int i = start; i < end; ++i) {
+            float fade = gLife[i] * gInvLife[i];
+            if (fade > 1.0f) fade = 1.0f;
+            Color c = gColor[i];
+            rlColor4ub(c.r, c.g, c.b, (unsigned char)(c.a * fade));
+            float x0 = gX[i], y0 = gY[i], s = gSize[i];
+            rlTexCoord2f(0.0f, 0.0f); rlVertex2f(x0, y0);
+            rlTexCoord2f(0.0f, 1.0f); rlVertex2f(x0, y0 + s);
+            rlTexCoord2f(1.0f, 1.0f); rlVertex2f(x0 + s, y0 + s);
+            rlTexCoord2f(1.0f, 0.0f); rlVertex2f(x0 + s, y0);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
+
+int Particles_Count(void) { return gCount; }
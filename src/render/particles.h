@@ -0,0 +1,40 @@
+// Partículas de efeito (superfície dos lagos, ventiladores e mortes).
+// Pool de capacidade fixa em estrutura de arrays, integrado com SSE quando
+// disponível e desenhado num único lote de quads.
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include "../objects/lake.h"
+
+#define PARTICLE_CAPACITY     32768
+#define PARTICLE_MAX_EMITTERS 256
+
+typedef enum {
+    PARTICLE_LAKE_WATER = 0,   // bolhas subindo
+    PARTICLE_LAKE_FIRE,        // brasas
+    PARTICLE_LAKE_EARTH,       // poeira
+    PARTICLE_LAKE_POISON,      // bolhas verdes
+    PARTICLE_FAN_UP,           // correntes de ar (ventilador empurrando para cima)
+    PARTICLE_FAN_DOWN,         // correntes de ar para baixo
+    PARTICLE_KIND_COUNT
+} ParticleKind;
+
+// Limpa partículas e emissores (início/fim de cada fase)
+void Particles_Reset(void);
+
+// Emissor contínuo numa área; rate em partículas por segundo. Retorna o id ou -1.
+int Particles_AddEmitter(ParticleKind kind, Rectangle area, float rate);
+void Particles_SetEmitterActive(int id, bool active);
+// Um emissor na superfície de cada lago
+void Particles_AddLakeEmitter(Rectangle lakeRect, LakeType type);
+
+// Explosão de partículas no lugar onde um jogador morreu
+void Particles_BurstDeath(Rectangle playerRect, LakeType lakeType);
+
+void Particles_Update(float dt);
+void Particles_Draw(void);   // dentro do BeginMode2D
+int Particles_Count(void);
+
+#endif
@@ -0,0 +1,142 @@
+#include "render_scale.h"
+#include <math.h>
+
+static RenderTexture2D gTarget = {0};
+static float gScale = 1.0f;
+static bool gDynamic = false;
+static RenderScaleFilter gFilter = RENDER_FILTER_NEAREST;
+static float gTargetFrame = 1.0f / 60.0f;
+static float gAvgFrame = 1.0f / 60.0f;
+static float gCooldown = 0.0f;
+static float gHeadroom = 0.0f;
+static bool gInWorld = false;
+static int gPreset = 0; // 0=100%, 1=75%, 2=50%, 3=dinâmico
+
+static float ClampScale(float s) {
+    if (s < RENDER_SCALE_MIN) s = RENDER_SCALE_MIN;
+    if (s > RENDER_SCALE_MAX) s = RENDER_SCALE_MAX;
+    // Quantiza em passos para não recriar a textura por variações mínimas
+    return roundf(s / RENDER_SCALE_STEP) * RENDER_SCALE_STEP;
+}
+
+static bool UsingTarget(void) {
+    return gDynamic || gScale < RENDER_SCALE_MAX;
+}
+
+static void ApplyFilter(void) {
+    if (gTarget.id == 0) return;
+    SetTextureFilter(gTarget.texture, gFilter == RENDER_FILTER_BILINEAR ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+}
+
+static void EnsureTarget(void) {
+    int w = (int)(GetScreenWidth() * gScale + 0.5f);
+    int h = (int)(GetScreenHeight() * gScale + 0.5f);
+    if (w < 1) w = 1;
+    if (h < 1) h = 1;
+    if (gTarget.id != 0 && gTarget.texture.width == w && gTarget.texture.height == h) return;
+    if (gTarget.id != 0) UnloadRenderTexture(gTarget);
+    gTarget = LoadRenderTexture(w, h);
+    ApplyFilter();
+}
+
+void RenderScale_Init(void) {
+    gAvgFrame = gTargetFrame;
+    gCooldown = 0.0f;
+    gHeadroom = 0.0f;
+    if (UsingTarget()) EnsureTarget();
+}
+
+void RenderScale_Shutdown(void) {
+    if (gTarget.id != 0) UnloadRenderTexture(gTarget);
+    gTarget = (RenderTexture2D){0};
+}
+
+void RenderScale_SetScale(float scale) {
+    gDynamic = false;
+    gScale = ClampScale(scale);
+    gPreset = gScale >= RENDER_SCALE_MAX ? 0 : (gScale >= 0.75f ? 1 : 2);
+}
+
+void RenderScale_SetDynamic(bool enabled, int targetFps) {
+    gDynamic = enabled;
+    if (targetFps > 0) gTargetFrame = 1.0f / (float)targetFps;
+    gAvgFrame = gTargetFrame;
+    gCooldown = 0.0f;
+    gHeadroom = 0.0f;
+    if (enabled) gPreset = 3;
+}
+
+void RenderScale_SetFilter(RenderScaleFilter filter) {
+    gFilter = filter;
+    ApplyFilter();
+}
+
+float RenderScale_GetScale(void) { return gScale; }
+bool RenderScale_IsDynamic(void) { return gDynamic; }
+
+void RenderScale_Update(void) {
+    if (IsKeyPressed(KEY_F9)) {
+        gPreset = (gPreset + 1) % 4;
+        switch (gPreset) {
+            case 0: RenderScale_SetScale(1.0f); break;
+            case 1: RenderScale_SetScale(0.75f); break;
+            case 2: RenderScale_SetScale(0.5f); break;
+            default: RenderScale_SetDynamic(true, 0); break;
+        }
+    }
+    if (IsKeyPressed(KEY_F10)) {
+        RenderScale_SetFilter(gFilter == RENDER_FILTER_NEAREST ? RENDER_FILTER_BILINEAR : RENDER_FILTER_NEAREST);
+    }
+    if (!gDynamic) return;
+
+    float dt = GetFrameTime();
+    gAvgFrame = gAvgFrame * 0.9f + dt * 0.1f;
+    if (gCooldown > 0.0f) { gCooldown -= dt; return; }
+
+    // Com SetTargetFPS o tempo de frame nunca fica abaixo do alvo, então só dá para
+    // detectar folga indiretamente: sobe um passo depois de 2s estáveis no alvo.
+    if (gAvgFrame > gTargetFrame * 1.10f) {
+        if (gScale > RENDER_SCALE_MIN) {
+            gScale = ClampScale(gScale - RENDER_SCALE_STEP);
+            gCooldown = 0.5f;
+        }
+        gHeadroom = 0.0f;
+    } else if (gAvgFrame < gTargetFrame * 1.03f) {
+        gHeadroom += dt;
+        if (gHeadroom >= 2.0f && gScale < RENDER_SCALE_MAX) {
+            gScale = ClampScale(gScale + RENDER_SCALE_STEP);
+            gCooldown = 0.5f;
+            gHeadroom = 0.0f;
+        }
+    } else {
+        gHeadroom = 0.0f;
+    }
+}
+
+void RenderScale_BeginWorld(void) {
+    gInWorld = false;
+    if (!UsingTarget()) return;
+    EnsureTarget();
+    BeginTextureMode(gTarget);
+    ClearBackground(BLACK);
+    gInWorld = true;
+}
+
+Camera2D RenderScale_WorldCamera(Camera2D camera) {
+    if (!gInWorld) return camera;
+    float s = (float)gTarget.texture.width / (float)GetScreenWidth();
+    camera.offset.x *= s;
+    camera.offset.y *= s;
+    camera.zoom *= s;
+    return camera;
+}
+
+void RenderScale_EndWorld(void) {
+    if (!gInWorld) return;
+    EndTextureMode();
+    gInWorld = false;
+    // Render textures ficam de cabeça para baixo no OpenGL: altura negativa na origem
+    Rectangle src = { 0, 0, (float)gTarget.texture.width, -(float)gTarget.texture.height };
+    Rectangle dst = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    DrawTexturePro(gTarget.texture, src, dst, (Vector2){0, 0}, 0.0f, WHITE);
+}
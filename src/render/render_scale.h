@@ -0,0 +1,38 @@
+// Resolução interna de renderização: o mundo das fases é desenhado numa
+// RenderTexture menor que a janela e ampliado no fim do frame.
+#ifndef RENDER_SCALE_H
+#define RENDER_SCALE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define RENDER_SCALE_MIN  0.5f
+#define RENDER_SCALE_MAX  1.0f
+#define RENDER_SCALE_STEP 0.05f
+
+typedef enum {
+    RENDER_FILTER_NEAREST = 0,   // pixels inteiros (ideal em 50%)
+    RENDER_FILTER_BILINEAR
+} RenderScaleFilter;
+
+void RenderScale_Init(void);
+void RenderScale_Shutdown(void);
+
+// Escala fixa (0.5..1.0); desliga o modo dinâmico
+void RenderScale_SetScale(float scale);
+// Modo dinâmico: ajusta a escala pelo tempo de frame para segurar o FPS alvo
+void RenderScale_SetDynamic(bool enabled, int targetFps);
+void RenderScale_SetFilter(RenderScaleFilter filter);
+float RenderScale_GetScale(void);
+bool RenderScale_IsDynamic(void);
+
+// Chamar uma vez por frame: teclas F9 (alterna 100/75/50/dinâmico), F10 (filtro)
+// e adaptação do modo dinâmico
+void RenderScale_Update(void);
+
+// Envolvem o desenho do mundo (entre BeginDrawing e o HUD)
+void RenderScale_BeginWorld(void);
+Camera2D RenderScale_WorldCamera(Camera2D camera);
+void RenderScale_EndWorld(void);
+
+#endif
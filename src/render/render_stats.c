@@ -0,0 +1,162 @@
+#include "render_stats.h"
+#include "rlgl.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char* kSectionNames[RENDER_SECTION_COUNT] = {
+    [RENDER_SECTION_OTHER]   = "Outros",
+    [RENDER_SECTION_MAP]     = "Mapa",
+    [RENDER_SECTION_PROPS]   = "Objetos",
+    [RENDER_SECTION_LAKES]   = "Lagos",
+    [RENDER_SECTION_BUTTONS] = "Botoes",
+    [RENDER_SECTION_PLAYERS] = "Jogadores",
+    [RENDER_SECTION_PARTICLES] = "Particulas",
+    [RENDER_SECTION_DEBUG]   = "Debug",
+    [RENDER_SECTION_HUD]     = "HUD",
+};
+
+static rlRenderBatch gBatch;
+static bool gBatchLoaded = false;
+static bool gEnabled = false;
+static bool gInFrame = false;
+
+static RenderFrameStats gCur;
+static RenderFrameStats gLast;
+static RenderSection gSection = RENDER_SECTION_OTHER;
+static double gSectionStart = 0.0;
+static unsigned int gBoundTexture = 0;
+
+static FILE* gCsv = NULL;
+static long gCsvFrame = 0;
+
+// Lê as chamadas acumuladas no lote e o envia, atribuindo tudo à seção atual.
+// Trocas de textura contam só quando o id muda entre chamadas consecutivas.
+static void CollectBatch(void) {
+    bool any = false;
+    for (int i = 0; i < gBatch.drawCounter; ++i) {
+        const rlDrawCall* d = &gBatch.draws[i];
+        if (d->vertexCount <= 0) continue;
+        any = true;
+        gCur.drawCalls++;
+        gCur.sectionDraws[gSection]++;
+        gCur.vertices += d->vertexCount;
+        if (d->textureId != gBoundTexture) { gCur.textureBinds++; gBoundTexture = d->textureId; }
+    }
+    if (!any) return;
+    rlDrawRenderBatchActive();
+    gCur.flushes++;
+    gBoundTexture = 0; // a rlgl desvincula a textura no fim do envio
+}
+
+void RenderStats_SetEnabled(bool enabled) {
+    if (enabled == gEnabled) return;
+    if (enabled) {
+        if (!gBatchLoaded) {
+            gBatch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+            gBatchLoaded = true;
+        }
+        rlSetRenderBatchActive(&gBatch);
+        memset(&gLast, 0, sizeof(gLast));
+    } else {
+        rlSetRenderBatchActive(NULL);
+        if (gCsv) RenderStats_ToggleCsv(NULL);
+    }
+    gEnabled = enabled;
+    gInFrame = false;
+}
+
+bool RenderStats_IsEnabled(void) { return gEnabled; }
+
+void RenderStats_Shutdown(void) {
+    RenderStats_SetEnabled(false);
+    if (gBatchLoaded) rlUnloadRenderBatch(gBatch);
+    gBatchLoaded = false;
+}
+
+void RenderStats_BeginFrame(void) {
+    if (!gEnabled) return;
+    memset(&gCur, 0, sizeof(gCur));
+    gSection = RENDER_SECTION_OTHER;
+    gSectionStart = GetTime();
+    gBoundTexture = 0;
+    gInFrame = true;
+}
+
+void RenderStats_Begin(RenderSection section) {
+    if (!gEnabled || !gInFrame) return;
+    // O que estiver pendente fora de seção fica em "Outros"
+    double now = GetTime();
+    if (gSection == RENDER_SECTION_OTHER) {
+        CollectBatch();
+        now = GetTime();
+        gCur.sectionMs[RENDER_SECTION_OTHER] += (now - gSectionStart) * 1000.0;
+    }
+    gSection = section;
+    gSectionStart = now;
+}
+
+void RenderStats_End(void) {
+    if (!gEnabled || !gInFrame) return;
+    CollectBatch();
+    double now = GetTime();
+    gCur.sectionMs[gSection] += (now - gSectionStart) * 1000.0;
+    gSection = RENDER_SECTION_OTHER;
+    gSectionStart = now;
+}
+
+void RenderStats_Collect(void) {
+    if (!gEnabled || !gInFrame) return;
+    CollectBatch();
+}
+
+void RenderStats_EndFrame(void) {
+    if (!gEnabled || !gInFrame) return;
+    if (gSection != RENDER_SECTION_OTHER) RenderStats_End();
+    RenderStats_Begin(RENDER_SECTION_OTHER);
+    gLast = gCur;
+    gInFrame = false;
+
+    if (gCsv) {
+        fprintf(gCsv, "%ld,%d,%d,%d,%d", gCsvFrame++, gLast.drawCalls, gLast.vertices, gLast.textureBinds, gLast.flushes);
+        for (int s = 0; s < RENDER_SECTION_COUNT; ++s) fprintf(gCsv, ",%d,%.4f", gLast.sectionDraws[s], gLast.sectionMs[s]);
+        fputc('\n', gCsv);
+    }
+}
+
+const RenderFrameStats* RenderStats_Last(void) { return &gLast; }
+
+void RenderStats_DrawOverlay(int x, int y) {
+    if (!gEnabled) return;
+    const int fs = 18, lh = 20;
+    DrawText(TextFormat("Draw calls: %d  Vertices: %d", gLast.drawCalls, gLast.vertices), x, y, fs, LIME);
+    y += lh;
+    DrawText(TextFormat("Trocas de textura: %d  Flushes: %d", gLast.textureBinds, gLast.flushes), x, y, fs, LIME);
+    y += lh;
+    for (int s = 0; s < RENDER_SECTION_COUNT; ++s) {
+        if (gLast.sectionDraws[s] == 0 && gLast.sectionMs[s] < 0.005) continue;
+        DrawText(TextFormat("%-10s %6.3f ms  %3d draws", kSectionNames[s], gLast.sectionMs[s], gLast.sectionDraws[s]), x, y, fs, RAYWHITE);
+        y += lh;
+    }
+    DrawText(gCsv ? "F11 - CSV: gravando" : "F11 - CSV: desligado", x, y, fs, gCsv ? RED : GRAY);
+}
+
+bool RenderStats_ToggleCsv(const char* path) {
+    if (gCsv) {
+        fclose(gCsv);
+        gCsv = NULL;
+        return false;
+    }
+    if (!path) return false;
+    gCsv = fopen(path, "w");
+    if (!gCsv) {
+        TraceLog(LOG_WARNING, "RenderStats: nao foi possivel abrir %s", path);
+        return false;
+    }
+    gCsvFrame = 0;
+    fprintf(gCsv, "frame,draw_calls,vertices,texture_binds,flushes");
+    for (int s = 0; s < RENDER_SECTION_COUNT; ++s) fprintf(gCsv, ",%s_draws,%s_ms", kSectionNames[s], kSectionNames[s]);
+    fputc('\n', gCsv);
+    return true;
+}
+
+bool RenderStats_IsLogging(void) { return gCsv != NULL; }
@@ -0,0 +1,56 @@
+// Instrumentação do desenho: conta draw calls, vértices, trocas de textura e
+// flushes do lote da rlgl por frame, e o tempo de envio de cada subsistema.
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+typedef enum {
+    RENDER_SECTION_OTHER = 0,    // tudo que ficou fora de uma seção (ex.: blit da escala)
+    RENDER_SECTION_MAP,
+    RENDER_SECTION_PROPS,        // ventiladores, plataformas e caixas
+    RENDER_SECTION_LAKES,
+    RENDER_SECTION_BUTTONS,
+    RENDER_SECTION_PLAYERS,
+    RENDER_SECTION_PARTICLES,
+    RENDER_SECTION_DEBUG,
+    RENDER_SECTION_HUD,
+    RENDER_SECTION_COUNT
+} RenderSection;
+
+typedef struct {
+    int drawCalls;
+    int vertices;
+    int textureBinds;
+    int flushes;
+    int sectionDraws[RENDER_SECTION_COUNT];
+    double sectionMs[RENDER_SECTION_COUNT];
+} RenderFrameStats;
+
+// Só mede enquanto ligado: troca o lote padrão da rlgl por um próprio, cujo
+// conteúdo é lido e enviado ao fim de cada seção. Desligado, tudo vira no-op.
+void RenderStats_SetEnabled(bool enabled);
+bool RenderStats_IsEnabled(void);
+void RenderStats_Shutdown(void);
+
+// BeginFrame logo após BeginDrawing; EndFrame logo antes de EndDrawing
+void RenderStats_BeginFrame(void);
+void RenderStats_EndFrame(void);
+
+// Seções não se aninham e não devem conter trocas de modo (Mode2D, TextureMode...):
+// essas trocas esvaziam o lote sem passar pela contagem.
+void RenderStats_Begin(RenderSection section);
+void RenderStats_End(void);
+// Para quem troca de modo dentro de uma seção (ex.: EndShaderMode dos lagos)
+void RenderStats_Collect(void);
+
+// Números do último frame completo
+const RenderFrameStats* RenderStats_Last(void);
+void RenderStats_DrawOverlay(int x, int y);
+
+// Log em CSV (uma linha por frame medido); alterna entre abrir e fechar o arquivo
+bool RenderStats_ToggleCsv(const char* path);
+bool RenderStats_IsLogging(void);
+
+#endif
@@ -0,0 +1,132 @@
+#include "aabb_soa.h"
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define AABB_SSE 1
+#endif
+
+// AVX é compilado só nesta função (atributo target) e escolhido se a CPU tiver;
+// o resto do jogo continua sem -mavx
+#if defined(AABB_SSE) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define AABB_AVX 1
+#endif
+
+static int RoundLanes(int n) {
+    return (n + AABB_SOA_LANES - 1) / AABB_SOA_LANES * AABB_SOA_LANES;
+}
+
+bool AabbSoa_Init(AabbSoa* s, int count) {
+    memset(s, 0, sizeof(*s));
+    if (count < 0) count = 0;
+    int cap = RoundLanes(count > 0 ? count : 1);
+    size_t bytes = (size_t)cap * sizeof(float);
+    s->block = malloc(bytes * 4 + AABB_SOA_ALIGN);
+    if (!s->block) return false;
+
+    uintptr_t base = ((uintptr_t)s->block + AABB_SOA_ALIGN - 1) & ~(uintptr_t)(AABB_SOA_ALIGN - 1);
+    s->minX = (float*)base;
+    s->minY = (float*)(base + bytes);
+    s->maxX = (float*)(base + bytes * 2);
+    s->maxY = (float*)(base + bytes * 3);
+    s->count = count;
+    s->capacity = cap;
+
+    // Caixa vazia invertida: nunca toca nada, então as pistas de sobra não dão falso positivo
+    for (int i = 0; i < cap; ++i) {
+        s->minX[i] = s->minY[i] = FLT_MAX;
+        s->maxX[i] = s->maxY[i] = -FLT_MAX;
+    }
+    return true;
+}
+
+void AabbSoa_Free(AabbSoa* s) {
+    free(s->block);
+    memset(s, 0, sizeof(*s));
+}
+
+void AabbSoa_Set(AabbSoa* s, int index, Rectangle r) {
+    if (index < 0 || index >= s->count) return;
+    s->minX[index] = r.x;
+    s->minY[index] = r.y;
+    s->maxX[index] = r.x + r.width;
+    s->maxY[index] = r.y + r.height;
+}
+
+static unsigned int OverlapScalar(const AabbSoa* s, int first, int count, Rectangle box) {
+    float bx0 = box.x, by0 = box.y, bx1 = box.x + box.width, by1 = box.y + box.height;
+    unsigned int mask = 0;
+    for (int i = 0; i < count; ++i) {
+        int k = first + i;
+        if (bx0 < s->maxX[k] && bx1 > s->minX[k] && by0 < s->maxY[k] && by1 > s->minY[k]) mask |= 1u << i;
+    }
+    return mask;
+}
+
+#ifdef AABB_SSE
+static unsigned int OverlapSse(const AabbSoa* s, int first, int count, Rectangle box) {
+    __m128 bx0 = _mm_set1_ps(box.x), by0 = _mm_set1_ps(box.y);
+    __m128 bx1 = _mm_set1_ps(box.x + box.width), by1 = _mm_set1_ps(box.y + box.height);
+    unsigned int mask = 0;
+    for (int i = 0; i < count; i += 4) {
+        int k = first + i;
+        __m128 hit = _mm_and_ps(
+            _mm_and_ps(_mm_cmplt_ps(bx0, _mm_loadu_ps(s->maxX + k)), _mm_cmpgt_ps(bx1, _mm_loadu_ps(s->minX + k))),
+            _mm_and_ps(_mm_cmplt_ps(by0, _mm_loadu_ps(s->maxY + k)), _mm_cmpgt_ps(by1, _mm_loadu_ps(s->minY + k))));
+        mask |= (unsigned int)_mm_movemask_ps(hit) << i;
+    }
+    return mask;
+}
+#endif
+
+#ifdef AABB_AVX
+__attribute__((target("avx")))
+static unsigned int OverlapAvx(const AabbSoa* s, int first, int count, Rectangle box) {
+    __m256 bx0 = _mm256_set1_ps(box.x), by0 = _mm256_set1_ps(box.y);
+    __m256 bx1 = _mm256_set1_ps(box.x + box.width), by1 = _mm256_set1_ps(box.y + box.height);
+    unsigned int mask = 0;
+    for (int i = 0; i < count; i += 8) {
+        int k = first + i;
+        __m256 hit = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(bx0, _mm256_loadu_ps(s->maxX + k), _CMP_LT_OQ),
+                          _mm256_cmp_ps(bx1, _mm256_loadu_ps(s->minX + k), _CMP_GT_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(by0, _mm256_loadu_ps(s->maxY + k), _CMP_LT_OQ),
+                          _mm256_cmp_ps(by1, _mm256_loadu_ps(s->minY + k), _CMP_GT_OQ)));
+        mask |= (unsigned int)_mm256_movemask_ps(hit) << i;
+    }
+    return mask;
+}
+#endif
+
+typedef unsigned int (*OverlapFn)(const AabbSoa*, int, int, Rectangle);
+// Escalar até AabbSoa_SelectBackend: nada é escolhido sob demanda, então a thread
+// de simulação só lê estas variáveis
+static OverlapFn gOverlap = OverlapScalar;
+static const char* gBackend = "escalar";
+static int gLanes = 1;
+
+void AabbSoa_SelectBackend(void) {
+#ifdef AABB_SSE
+    gOverlap = OverlapSse; gBackend = "SSE"; gLanes = 4;
+#endif
+#ifdef AABB_AVX
+    if (__builtin_cpu_supports("avx")) { gOverlap = OverlapAvx; gBackend = "AVX"; gLanes = 8; }
+#endif
+}
+
+unsigned int AabbSoa_Overlap(const AabbSoa* s, int first, int count, Rectangle box) {
+    if (count <= 0) return 0;
+    if (count > 32) count = 32;
+    // Os kernels leem blocos inteiros de pistas: o fim não pode passar da capacidade
+    if (first + (count + gLanes - 1) / gLanes * gLanes > s->capacity) return OverlapScalar(s, first, count, box);
+    unsigned int mask = gOverlap(s, first, count, box);
+    return count == 32 ? mask : mask & ((1u << count) - 1u);
+}
+
+const char* AabbSoa_Backend(void) {
+    return gBackend;
+}
@@ -0,0 +1,37 @@
+// Retângulos em estrutura de vetores (minX/minY/maxX/maxY separados e alinhados)
+// para testar uma caixa contra vários de uma vez: 8 por instrução com AVX,
+// 4 com SSE, um a um no caminho escalar. O resultado é uma máscara de bits.
+#ifndef AABB_SOA_H
+#define AABB_SOA_H
+
+#include <stdbool.h>
+#include "../game/sim_types.h"
+
+#define AABB_SOA_ALIGN 32   // bytes (um registrador AVX)
+#define AABB_SOA_LANES 8    // capacidade arredondada para múltiplo disto
+
+typedef struct AabbSoa {
+    float* minX;
+    float* minY;
+    float* maxX;
+    float* maxY;
+    int count;
+    int capacity;           // múltiplo de AABB_SOA_LANES; sobra preenchida com caixas vazias
+    void* block;            // alocação única que contém os quatro vetores
+} AabbSoa;
+
+bool AabbSoa_Init(AabbSoa* s, int count);
+void AabbSoa_Free(AabbSoa* s);
+void AabbSoa_Set(AabbSoa* s, int index, Rectangle r);
+
+// Bit i ligado se box toca o retângulo first+i (mesmo critério de CheckCollisionRecs).
+// count até 32 por chamada.
+unsigned int AabbSoa_Overlap(const AabbSoa* s, int first, int count, Rectangle box);
+
+// Escolhe o kernel pela CPU (AVX, SSE ou escalar). Chamar uma vez no início do
+// programa, antes de qualquer thread; sem a chamada fica o caminho escalar.
+void AabbSoa_SelectBackend(void);
+// Nome do caminho escolhido em tempo de execução ("AVX", "SSE" ou "escalar")
+const char* AabbSoa_Backend(void);
+
+#endif
@@ -0,0 +1,40 @@
+#include "spsc_ring.h"
+
+bool SpscRing_Init(SpscRing* r) {
+    atomic_store(&r->head, 0u);
+    atomic_store(&r->tail, 0u);
+    return sem_init(&r->ready, 0, 0) == 0;
+}
+
+void SpscRing_Destroy(SpscRing* r) {
+    sem_destroy(&r->ready);
+}
+
+bool SpscRing_Push(SpscRing* r, int value) {
+    unsigned head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    if (head - tail >= SPSC_RING_CAPACITY) return false;
+    r->items[head % SPSC_RING_CAPACITY] = value;
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+    sem_post(&r->ready);
+    return true;
+}
+
+static int TakeFront(SpscRing* r) {
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    int value = r->items[tail % SPSC_RING_CAPACITY];
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+    return value;
+}
+
+bool SpscRing_TryPop(SpscRing* r, int* out) {
+    // Cada item tem exatamente um post: consumir o item consome o post junto
+    if (sem_trywait(&r->ready) != 0) return false;
+    *out = TakeFront(r);
+    return true;
+}
+
+int SpscRing_Pop(SpscRing* r) {
+    while (sem_wait(&r->ready) != 0) { /* interrompido por sinal: tenta de novo */ }
+    return TakeFront(r);
+}
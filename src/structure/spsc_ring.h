@@ -0,0 +1,29 @@
+// Fila circular de um produtor e um consumidor (threads diferentes), sem lock.
+// Carrega índices inteiros; o semáforo só serve para o consumidor dormir.
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <semaphore.h>
+
+#define SPSC_RING_CAPACITY 4
+
+typedef struct {
+    atomic_uint head;   // escrito só pelo produtor
+    atomic_uint tail;   // escrito só pelo consumidor
+    int items[SPSC_RING_CAPACITY];
+    sem_t ready;
+} SpscRing;
+
+bool SpscRing_Init(SpscRing* r);
+void SpscRing_Destroy(SpscRing* r);
+
+// Produtor: false se a fila estiver cheia
+bool SpscRing_Push(SpscRing* r, int value);
+// Consumidor: false se vazia (não bloqueia)
+bool SpscRing_TryPop(SpscRing* r, int* out);
+// Consumidor: bloqueia até chegar um item
+int SpscRing_Pop(SpscRing* r);
+
+#endif
@@ -0,0 +1,187 @@
+// Roda o núcleo de simulação (SimWorld) sem janela, sem GPU e sem teclado:
+//   build/sim_headless [ticks] [semente] [portas|coop]
+// portas (padrão): mapa da fase 3; os três jogadores recebem entradas
+// pseudoaleatórias determinísticas (mesma semente = mesma partida).
+// coop: mapa da fase 4 em cenas de SCENE_TICKS, em rodízio, para passar por
+// caixas, barra/elevadores e ventilador: dois jogadores empurram a caixa; dois
+// ficam em botões e um vai em cima de uma plataforma; os três caem na corrente
+// do ventilador. Quem não tem papel na cena anda ao acaso.
+// No fim sai um resumo com o hash do estado e ticks por segundo.
+#include "../src/game/sim_world.h"
+#include "../src/game/sim_rect.h"
+#include "../src/structure/aabb_soa.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DOORS_TMX    "assets/maps/fase3/fase3.tmx"
+#define COOP_TMX     "assets/maps/fase4/fase4.tmx"
+#define SCENE_TICKS  240
+#define SCENE_COUNT  3
+
+// Ticks em que cada parte do mapa cooperativo realmente agiu
+typedef struct Coverage {
+    long long box;
+    long long platform;
+    long long field;
+} Coverage;
+
+static unsigned int NextRandom(unsigned int* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+// Segura uma direção por um trecho aleatório e pula às vezes
+static void RandomInput(PlayerInput* in, int* hold, unsigned int* seed) {
+    if (--*hold <= 0) {
+        unsigned int r = NextRandom(seed);
+        in->left  = (r % 3) == 0;
+        in->right = (r % 3) == 1;
+        *hold = 10 + (int)((r >> 4) % 50);
+    }
+    in->jumpPressed = (NextRandom(seed) % 40) == 0;
+}
+
+// Pés do jogador na base de r, centrado
+static Vector2 StandOn(Rectangle r) {
+    return (Vector2){ r.x + r.width * 0.5f - PLAYER_HITBOX_WIDTH * 0.5f, r.y + r.height - PLAYER_HITBOX_HEIGHT };
+}
+
+// Posiciona os jogadores da cena; scripted[p] = entrada fixa em in[p] até a próxima cena
+static void StartCoopScene(SimWorld* w, int scene, unsigned int* seed, SimInput* in, bool* scripted) {
+    memset(in, 0, sizeof(*in));
+    for (int p = 0; p < SIM_PLAYERS; ++p) scripted[p] = false;
+    if (scene == 0 && w->boxCount > 0) {
+        Rectangle box = w->boxes[NextRandom(seed) % (unsigned int)w->boxCount].rect;
+        bool fromLeft = (NextRandom(seed) % 2) == 0;
+        for (int p = 0; p < 2; ++p) {
+            float x = fromLeft ? box.x - (PLAYER_HITBOX_WIDTH + 1.0f) * (float)(p + 1)
+                               : box.x + box.width + 1.0f + (PLAYER_HITBOX_WIDTH + 1.0f) * (float)p;
+            SimWorld_PlacePlayer(w, p, (Vector2){ x, box.y + box.height - PLAYER_HITBOX_HEIGHT });
+            in->players[p].right = fromLeft;
+            in->players[p].left = !fromLeft;
+            scripted[p] = true;
+        }
+    } else if (scene == 1 && w->buttonCount > 0) {
+        for (int p = 0; p < 2; ++p) {
+            SimWorld_PlacePlayer(w, p, StandOn(w->buttons[NextRandom(seed) % (unsigned int)w->buttonCount].rect));
+            scripted[p] = true;
+        }
+        const SimPlatform* pf = &w->platforms[NextRandom(seed) % (unsigned int)(w->platformCount > 0 ? w->platformCount : 1)];
+        if (w->platformCount > 0 && pf->body >= 0) {
+            Rectangle top = pf->plat.rect;
+            SimWorld_PlacePlayer(w, PHASE_WATER, (Vector2){ top.x + top.width * 0.5f - PLAYER_HITBOX_WIDTH * 0.5f,
+                                                           top.y - PLAYER_HITBOX_HEIGHT });
+            scripted[PHASE_WATER] = true;
+        }
+    } else if (scene == 2 && w->forceFields.count > 0) {
+        Rectangle fan = w->forceFields.volumes[0].rect;
+        int room = (int)(fan.width - PLAYER_HITBOX_WIDTH);
+        for (int p = 0; p < SIM_PLAYERS; ++p) {
+            float dx = room > 0 ? (float)(NextRandom(seed) % (unsigned int)room) : 0.0f;
+            SimWorld_PlacePlayer(w, p, (Vector2){ fan.x + dx, fan.y });
+        }
+    }
+}
+
+static void TrackCoverage(const SimWorld* w, const Box* boxesBefore, const float* platformYBefore, Coverage* c) {
+    for (int b = 0; b < w->boxCount; ++b) {
+        if (w->boxes[b].rect.x != boxesBefore[b].rect.x || w->boxes[b].rect.y != boxesBefore[b].rect.y) { c->box++; break; }
+    }
+    for (int i = 0; i < w->platformCount; ++i) {
+        if (w->platforms[i].plat.rect.y != platformYBefore[i]) { c->platform++; break; }
+    }
+    bool inField = false;
+    for (int i = 0; i < w->forceFields.count && !inField; ++i) {
+        if (!ForceFieldWorld_Active(&w->forceFields, i)) continue;
+        for (int p = 0; p < SIM_PLAYERS && !inField; ++p)
+            inField = SimRectsOverlap(w->players[p].rect, w->forceFields.volumes[i].rect);
+    }
+    if (inField) c->field++;
+}
+
+int main(int argc, char** argv) {
+    long long ticks = argc > 1 ? atoll(argv[1]) : 100000;
+    unsigned int seed = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 10) : 1u;
+    bool coop = argc > 3 && strcmp(argv[3], "coop") == 0;
+    if (argc > 3 && !coop && strcmp(argv[3], "portas") != 0) {
+        fprintf(stderr, "mapa desconhecido: %s (use portas ou coop)\n", argv[3]);
+        return 1;
+    }
+    AabbSoa_SelectBackend();
+
+    const char* tmx = coop ? COOP_TMX : DOORS_TMX;
+    int mapW = 0, mapH = 0;
+    if (!PhaseMapSize(tmx, &mapW, &mapH)) {
+        fprintf(stderr, "mapa nao encontrado: %s\n", tmx);
+        return 1;
+    }
+    static SimWorld world;
+    bool loaded = coop ? SimWorld_LoadCoopMap(&world, tmx, mapW, mapH)
+                       : SimWorld_LoadDoorsMap(&world, tmx, mapW, mapH);
+    if (!loaded) {
+        fprintf(stderr, "falha ao carregar %s\n", tmx);
+        return 1;
+    }
+
+    SimInput in = {0};
+    SimInput sceneInput = {0};
+    bool scripted[SIM_PLAYERS] = { false };
+    int hold[SIM_PLAYERS] = {0};
+    Coverage coverage = {0};
+    Box boxesBefore[SIM_MAX_BOXES];
+    float platformYBefore[SIM_MAX_PLATFORMS];
+    long long deaths = 0, done = 0;
+    clock_t start = clock();
+    for (; done < ticks && !world.finished; ++done) {
+        if (coop && done % SCENE_TICKS == 0)
+            StartCoopScene(&world, (int)(done / SCENE_TICKS) % SCENE_COUNT, &seed, &sceneInput, scripted);
+        for (int p = 0; p < SIM_PLAYERS; ++p) {
+            if (scripted[p]) in.players[p] = sceneInput.players[p];
+            else RandomInput(&in.players[p], &hold[p], &seed);
+        }
+        if (coop) {
+            memcpy(boxesBefore, world.boxes, sizeof(Box) * (size_t)world.boxCount);
+            for (int i = 0; i < world.platformCount; ++i) platformYBefore[i] = world.platforms[i].plat.rect.y;
+        }
+        SimWorld_Step(&world, &in);
+        deaths += world.deathCount;
+        if (coop) TrackCoverage(&world, boxesBefore, platformYBefore, &coverage);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("ticks: %lld (%.1f s de jogo)\n", done, SimClock_Seconds(&world.clock));
+    printf("mortes: %lld, concluiu: %s\n", deaths, world.finished ? "sim" : "nao");
+    for (int p = 0; p < SIM_PLAYERS; ++p) {
+        printf("jogador %d: (%.1f, %.1f) porta=%d\n", p,
+               world.players[p].rect.x, world.players[p].rect.y, world.reached[p]);
+    }
+    for (int b = 0; b < world.boxCount; ++b)
+        printf("caixa %d: (%.1f, %.1f)\n", b, world.boxes[b].rect.x, world.boxes[b].rect.y);
+    for (int i = 0; i < world.platformCount; ++i)
+        if (world.platforms[i].body >= 0) printf("plataforma %d: y=%.1f\n", i, world.platforms[i].plat.rect.y);
+    printf("hash do estado: %08x (%s)\n", (unsigned int)SimWorld_Hash(&world),
+#ifdef SIM_FIXED_POINT
+           "ponto fixo"
+#else
+           "float"
+#endif
+    );
+    if (seconds > 0) printf("%.0f ticks/s\n", done / seconds);
+
+    // Um hash igual só prova algo se a cena passou pelas partes: com todas as
+    // cenas rodadas ao menos uma vez, caixa, plataforma e ventilador precisam ter agido
+    int rc = 0;
+    if (coop) {
+        printf("cobertura: caixa %lld, plataformas %lld, ventilador %lld ticks\n",
+               coverage.box, coverage.platform, coverage.field);
+        if (done >= (long long)SCENE_TICKS * (SCENE_COUNT - 1) + 1 &&
+            (coverage.box == 0 || coverage.platform == 0 || coverage.field == 0)) {
+            fprintf(stderr, "cenario coop nao exercitou caixa, plataformas e ventilador\n");
+            rc = 2;
+        }
+    }
+    SimWorld_Free(&world);
+    return rc;
+}